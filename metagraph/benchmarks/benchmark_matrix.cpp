@@ -1,11 +1,13 @@
 #include "benchmark/benchmark.h"
 
+#include <random>
 #include <string>
 #include <vector>
 
 #include "method_constructors.hpp"
 
 #include "annotation/annotation_converters.hpp"
+#include "annotation/binary_matrix/base/column_counter.hpp"
 #include "annotation/representation/column_compressed/annotate_column_compressed.hpp"
 #include "graph/annotated_dbg.hpp"
 #include "common/vectors/vector_algorithm.hpp"
@@ -115,4 +117,38 @@ BENCHMARK_TEMPLATE(BM_BRWTQueryRows, 3000000, 100, 30, 2, false, 0)
     ->Unit(benchmark::kMillisecond)
     ->DenseRange(0, 10, 1);
 
+
+// Count the columns in |num_rows| random rows with |row_size| set bits each,
+// with the dense counter and with the hash map one
+template <bool dense, size_t num_rows = 10000, size_t row_size = 10>
+static void BM_ColumnCounter(benchmark::State& state) {
+    const size_t num_columns = state.range(0);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint64_t> column(0, num_columns - 1);
+    std::vector<annot::matrix::BinaryMatrix::SetBitPositions> rows(num_rows);
+    for (auto &row : rows) {
+        for (size_t i = 0; i < row_size; ++i) {
+            row.push_back(column(gen));
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    }
+
+    for (auto _ : state) {
+        annot::matrix::ColumnCounter counter(num_columns, dense ? num_columns : 0);
+        for (const auto &row : rows) {
+            counter.add(row, 1);
+        }
+        benchmark::DoNotOptimize(counter.get(1));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ColumnCounter, true)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK_TEMPLATE(BM_ColumnCounter, false)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(10)->Range(1'000, 10'000'000);
+
 } // namespace
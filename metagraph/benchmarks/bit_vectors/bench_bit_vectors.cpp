@@ -7,6 +7,8 @@
 #include "common/vectors/sd_vector_builder_disk.hpp"
 #include "common/vectors/bit_vector_sdsl.hpp"
 #include "common/vectors/bit_vector_sd.hpp"
+#include "common/vectors/wavelet_tree.hpp"
+#include "common/threads/threading.hpp"
 #include "common/data_generation.hpp"
 
 
@@ -226,4 +228,46 @@ BENCHMARK_TEMPLATE(BM_bv_query_random_sd_vector_access_every_nth_bit_set, sdsl::
 BENCHMARK_TEMPLATE(BM_bv_query_random_sd_vector_access_every_nth_bit_set, sdsl::mmap_ifstream, 200) -> Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(BM_bv_query_random_sd_vector_access_every_nth_bit_set, sdsl::mmap_ifstream, 100) -> Unit(benchmark::kMicrosecond);
 
+// Args: number of threads
+template <class bit_vector_type, uint64_t size, unsigned int density_promille>
+static void BM_bv_construct(benchmark::State& state) {
+    DataGenerator gen;
+    gen.set_seed(42);
+
+    const sdsl::bit_vector vector = gen.generate_random_column(size, density_promille / 1000.);
+    set_num_threads(state.range(0));
+
+    for (auto _ : state) {
+        bit_vector_type bv(vector);
+        benchmark::DoNotOptimize(bv.num_set_bits());
+    }
+
+    set_num_threads(1);
+    state.SetBytesProcessed(state.iterations() * size / 8);
+}
+
+BENCHMARK_TEMPLATE(BM_bv_construct, bit_vector_stat, 1'000'000'000, 500) -> Arg(1) -> Arg(2) -> Arg(4) -> Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_bv_construct, bit_vector_stat, 1'000'000'000, 10) -> Arg(1) -> Arg(2) -> Arg(4) -> Unit(benchmark::kMillisecond);
+
+// Args: number of threads
+template <class wavelet_tree_type, uint64_t size, uint8_t logsigma>
+static void BM_wt_construct(benchmark::State& state) {
+    sdsl::int_vector<> vector(size, 0, logsigma);
+    for (uint64_t i = 0; i < size; ++i) {
+        vector[i] = (i * 87'178'291'199) % (1llu << logsigma);
+    }
+    set_num_threads(state.range(0));
+
+    for (auto _ : state) {
+        wavelet_tree_type wt(logsigma, sdsl::int_vector<>(vector));
+        benchmark::DoNotOptimize(wt.count(0));
+    }
+
+    set_num_threads(1);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_wt_construct, wavelet_tree_fast, 200'000'000, 4) -> Arg(1) -> Arg(4) -> Arg(16) -> Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_wt_construct, wavelet_tree_stat, 200'000'000, 4) -> Arg(1) -> Arg(4) -> Arg(16) -> Unit(benchmark::kMillisecond);
+
 } // namespace
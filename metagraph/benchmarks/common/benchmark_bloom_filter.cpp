@@ -0,0 +1,59 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "common/bloom_filter.hpp"
+
+
+namespace {
+
+// large enough for the filter not to fit in cache
+const size_t kNumInserted = 1 << 24;
+const size_t kNumQueries = 1 << 22;
+
+std::vector<uint64_t> random_hashes(size_t size, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> hashes(size);
+    for (uint64_t &hash : hashes) {
+        hash = gen();
+    }
+    return hashes;
+}
+
+// Args: bits per inserted element, number of hash functions
+static void BM_BloomFilterCheck(benchmark::State& state) {
+    const size_t bits_per_element = state.range(0);
+    const uint32_t num_hash_functions = state.range(1);
+
+    BloomFilter filter(bits_per_element * kNumInserted, num_hash_functions);
+    auto inserted = random_hashes(kNumInserted, 42);
+    filter.insert(inserted.data(), inserted.data() + inserted.size());
+
+    // half of the queries are present
+    auto queries = random_hashes(kNumQueries, 43);
+    for (size_t i = 0; i < queries.size(); i += 2) {
+        queries[i] = inserted[i];
+    }
+
+    size_t num_present = 0;
+    for (auto _ : state) {
+        filter.check(queries.data(), queries.data() + queries.size(),
+                     [&](size_t) { num_present++; });
+        benchmark::DoNotOptimize(num_present);
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    state.counters["fill_rate"] = static_cast<double>(
+        sdsl::util::cnt_one_bits(filter.data())) / filter.size();
+    state.counters["probes/s"] = benchmark::Counter(
+        state.iterations() * queries.size(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_BloomFilterCheck)
+    ->Args({ 4, 1 })->Args({ 4, 3 })->Args({ 4, 6 })
+    ->Args({ 8, 1 })->Args({ 8, 3 })->Args({ 8, 6 })
+    ->Args({ 16, 1 })->Args({ 16, 3 })->Args({ 16, 6 })
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
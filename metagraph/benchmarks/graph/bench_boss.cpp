@@ -309,4 +309,78 @@ BENCHMARK(BM_BOSS_num_incoming_to_target) -> Unit(benchmark::kMicrosecond);
 
 DEFINE_BOSS_BENCHMARK(get_node_seq,  get_node_seq,              get_W,    size);
 
+
+// Compare the representations of W and last side by side.
+// Arg: the state to which the loaded graph is switched
+std::shared_ptr<DBGSuccinct> load_graph_in_state(benchmark::State &state) {
+    auto graph = load_graph(state);
+    if (graph->get_boss().num_edges())
+        graph->switch_state(static_cast<BOSS::State>(state.range(0)));
+    return graph;
+}
+
+#define STATE_ARGS \
+    Arg(BOSS::State::STAT)->Arg(BOSS::State::FAST)->Arg(BOSS::State::FUSED) \
+        -> Unit(benchmark::kMicrosecond)
+
+static void BM_BOSS_state_fwd(benchmark::State &state) {
+    auto graph = load_graph_in_state(state);
+    const BOSS &boss = graph->get_boss();
+
+    std::mt19937 gen(32);
+    std::uniform_int_distribution<uint64_t> dis(1, boss.get_W().size() - 1);
+
+    std::vector<std::pair<uint64_t, BOSS::TAlphabet>> edges;
+    edges.reserve(NUM_DISTINCT_INDEXES);
+    while (edges.size() < NUM_DISTINCT_INDEXES) {
+        uint64_t edge = dis(gen);
+        if (boss.get_W().size() <= 2 || boss.get_W(edge))
+            edges.emplace_back(edge, boss.get_W(edge) % boss.alph_size);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto edge = edges[i++ % NUM_DISTINCT_INDEXES];
+        benchmark::DoNotOptimize(boss.fwd(edge.first, edge.second));
+    }
+}
+BENCHMARK(BM_BOSS_state_fwd) -> STATE_ARGS;
+
+static void BM_BOSS_state_bwd(benchmark::State &state) {
+    auto graph = load_graph_in_state(state);
+    const BOSS &boss = graph->get_boss();
+
+    auto edges = random_numbers(NUM_DISTINCT_INDEXES, 1, boss.get_W().size() - 1);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boss.bwd(edges[i++ % NUM_DISTINCT_INDEXES]));
+    }
+}
+BENCHMARK(BM_BOSS_state_bwd) -> STATE_ARGS;
+
+static void BM_BOSS_state_pick_edge(benchmark::State &state) {
+    auto graph = load_graph_in_state(state);
+    const BOSS &boss = graph->get_boss();
+
+    std::mt19937 gen(32);
+    std::uniform_int_distribution<uint64_t> dis(1, boss.get_W().size() - 1);
+    std::uniform_int_distribution<BOSS::TAlphabet> label(1, boss.alph_size - 1);
+
+    std::vector<std::pair<uint64_t, BOSS::TAlphabet>> edges;
+    edges.reserve(NUM_DISTINCT_INDEXES);
+    while (edges.size() < NUM_DISTINCT_INDEXES) {
+        uint64_t edge = dis(gen);
+        if (boss.get_last(edge))
+            edges.emplace_back(edge, label(gen));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto edge = edges[i++ % NUM_DISTINCT_INDEXES];
+        benchmark::DoNotOptimize(boss.pick_edge(edge.first, edge.second));
+    }
+}
+BENCHMARK(BM_BOSS_state_pick_edge) -> STATE_ARGS;
+
 } // namespace
@@ -45,6 +45,8 @@ typedef TupleCSCMatrix<BRWT> TupleBRWT;
 
 const size_t kNumRowsInBlock = 50'000;
 const uint64_t ROW_DIFF_BUFFER_BYTES = 8'000'000;
+// smallest buffer allocated per column when packing many columns in one batch
+const uint64_t MIN_ROW_DIFF_BUFFER_BYTES = 100'000;
 
 
 // RowCompressed -> other
@@ -546,9 +548,10 @@ convert_to_BRWT<RowDiffBRWTAnnotator>(const std::vector<std::string> &annotation
             annotator->get_label_encoder());
 }
 
-void relax_BRWT(BRWT *annotation, size_t relax_max_arity, size_t num_threads) {
+void relax_BRWT(BRWT *annotation, size_t relax_max_arity, size_t num_threads,
+                size_t max_memory) {
     if (relax_max_arity > 1)
-        BRWTOptimizer::relax(annotation, relax_max_arity, num_threads);
+        BRWTOptimizer::relax(annotation, relax_max_arity, num_threads, max_memory);
 }
 
 using CallColumn = std::function<void(std::unique_ptr<bit_vector>&&)>;
@@ -1503,6 +1506,182 @@ void merge_brwt(const std::vector<std::string> &filenames,
     annotation.serialize(outfile);
 }
 
+bool equal_bits(const bit_vector &first, const bit_vector &second) {
+    if (first.size() != second.size() || first.num_set_bits() != second.num_set_bits())
+        return false;
+
+    for (uint64_t i = 0; i < first.size(); i += 64) {
+        const uint32_t width = std::min(uint64_t(64), first.size() - i);
+        if (first.get_int(i, width) != second.get_int(i, width))
+            return false;
+    }
+    return true;
+}
+
+// Load row-diff annotations with disjoint labels, checking that all of them
+// were transformed with the same anchors and fork successors
+template <class RowDiffAnnotator>
+std::vector<std::unique_ptr<RowDiffAnnotator>>
+load_row_diff_to_merge(const std::vector<std::string> &filenames,
+                       LEncoder *label_encoder) {
+    assert(filenames.size() && "nothing to merge");
+    assert(label_encoder);
+
+    std::vector<std::unique_ptr<RowDiffAnnotator>> annotators;
+
+    for (const auto &filename : filenames) {
+        if (!utils::ends_with(filename, RowDiffAnnotator::kExtension))
+            throw std::runtime_error("Can't merge annotations of mixed types");
+
+        auto annotator = std::make_unique<RowDiffAnnotator>();
+        if (!annotator->load(filename)) {
+            logger->error("Cannot load annotations from file '{}'", filename);
+            exit(1);
+        }
+
+        if (annotators.size()) {
+            const auto &first = annotators[0]->get_matrix();
+            const auto &matrix = annotator->get_matrix();
+
+            if (matrix.num_rows() != first.num_rows())
+                throw std::runtime_error("Annotators have different number of rows");
+
+            if (!equal_bits(matrix.anchor(), first.anchor())
+                    || !equal_bits(matrix.fork_succ(), first.fork_succ()))
+                throw std::runtime_error("Annotators were transformed with different"
+                                         " anchors or fork successors");
+        }
+
+        for (const auto &label : annotator->get_label_encoder().get_labels()) {
+            if (label_encoder->label_exists(label))
+                throw std::runtime_error("merging of row-diff annotations with same labels"
+                                         " is not implemented");
+
+            label_encoder->insert_and_encode(label);
+        }
+
+        annotators.push_back(std::move(annotator));
+    }
+
+    return annotators;
+}
+
+template <>
+void merge_row_diff<RowDiffColumnAnnotator>(const std::vector<std::string> &filenames,
+                                            const std::string &outfile,
+                                            size_t /*num_threads*/) {
+    LEncoder label_encoder;
+    auto annotators = load_row_diff_to_merge<RowDiffColumnAnnotator>(filenames,
+                                                                      &label_encoder);
+
+    // the anchors are stored with the graph, so the columns are simply concatenated
+    auto matrix = annotators[0]->release_matrix();
+    auto &columns = matrix->diffs().data();
+    for (size_t i = 1; i < annotators.size(); ++i) {
+        auto other = annotators[i]->release_matrix();
+        for (auto &column : other->diffs().data()) {
+            columns.push_back(std::move(column));
+        }
+    }
+
+    RowDiffColumnAnnotator(std::move(matrix), label_encoder).serialize(outfile);
+}
+
+template <>
+void merge_row_diff<RowDiffBRWTAnnotator>(const std::vector<std::string> &filenames,
+                                          const std::string &outfile,
+                                          size_t num_threads) {
+    LEncoder label_encoder;
+    auto annotators = load_row_diff_to_merge<RowDiffBRWTAnnotator>(filenames,
+                                                                    &label_encoder);
+
+    // keep the anchors and fork successors of the first annotation
+    std::vector<BRWT> brwts;
+    auto matrix = annotators[0]->release_matrix();
+    brwts.push_back(std::move(matrix->diffs()));
+    for (size_t i = 1; i < annotators.size(); ++i) {
+        brwts.push_back(std::move(annotators[i]->release_matrix()->diffs()));
+    }
+
+    // attach the input Multi-BRWTs as subtrees of a new root
+    matrix->diffs() = BRWTBottomUpBuilder::merge(
+        std::move(brwts),
+        BRWTBottomUpBuilder::get_basic_partitioner(-1),
+        1,
+        num_threads
+    );
+
+    RowDiffBRWTAnnotator(std::move(matrix), label_encoder).serialize(outfile);
+}
+
+template <>
+void merge_row_diff<RowDiffDiskAnnotator>(const std::vector<std::string> &filenames,
+                                          const std::string &outfile,
+                                          size_t num_threads) {
+    LEncoder label_encoder;
+    auto annotators = load_row_diff_to_merge<RowDiffDiskAnnotator>(filenames,
+                                                                    &label_encoder);
+
+    const auto &first = annotators[0]->get_matrix();
+    const uint64_t num_rows = first.num_rows();
+
+    std::vector<uint64_t> offsets(annotators.size(), 0);
+    uint64_t num_set_bits = annotators[0]->num_relations();
+    for (size_t i = 1; i < annotators.size(); ++i) {
+        offsets[i] = offsets[i - 1] + annotators[i - 1]->num_labels();
+        num_set_bits += annotators[i]->num_relations();
+    }
+
+    const auto outfname = utils::make_suffix(outfile, RowDiffDiskAnnotator::kExtension);
+
+    std::ofstream out = utils::open_new_ofstream(outfname);
+    if (!out.good())
+        throw std::ofstream::failure("Can't write to " + outfname);
+
+    label_encoder.serialize(out);
+    out.write("v2.0", 4);
+    first.anchor().serialize(out);
+    first.fork_succ().serialize(out);
+    out.close();
+
+    ProgressBar progress_bar(num_rows, "Merge rows", std::cerr, !common::get_verbose());
+
+    // the rows are stored in full, so they have to be rewritten with the new columns
+    RowDisk::serialize(
+            outfname,
+            [&](BinaryMatrix::RowCallback write_row) {
+                #pragma omp parallel for ordered num_threads(num_threads) schedule(dynamic)
+                for (uint64_t begin = 0; begin < num_rows; begin += kNumRowsInBlock) {
+                    uint64_t end = std::min(begin + kNumRowsInBlock, num_rows);
+
+                    std::vector<BinaryMatrix::SetBitPositions> rows(end - begin);
+
+                    // read the rows of each input in order through a single buffer
+                    for (size_t b = 0; b < annotators.size(); ++b) {
+                        size_t r = 0;
+                        annotators[b]->get_matrix().diffs().call_rows(begin, end,
+                            [&](const auto &input_row) {
+                                for (auto j : input_row) {
+                                    rows[r].push_back(j + offsets[b]);
+                                }
+                                ++r;
+                            }
+                        );
+                        assert(r == rows.size());
+                    }
+
+                    #pragma omp ordered
+                    {
+                        for (const auto &row : rows) {
+                            write_row(row);
+                            ++progress_bar;
+                        }
+                    }
+                }
+            },
+            label_encoder.size(), num_rows, num_set_bits);
+}
+
 template <typename Label>
 void convert_to_row_annotator(const ColumnCompressed<Label> &annotator,
                               const std::string &outfbase) {
@@ -1599,9 +1778,21 @@ void convert_to_row_diff(const std::vector<std::string> &files,
         logger->trace("Loading columns for batch-conversion...");
         size_t mem_bytes_left = mem_bytes;
         std::vector<std::string> file_batch;
+        uint64_t num_columns_in_batch = 0;
         for ( ; i < files.size(); ++i) {
-            // also add some space for buffers for each column
-            uint64_t file_size = (utils::with_mmap() ? 0 : fs::file_size(files[i])) + ROW_DIFF_BUFFER_BYTES;
+            // Reserve the minimum buffer for each column. The memory left after
+            // forming the batch is distributed among the buffers afterwards.
+            // This packs as many columns as possible in a batch and hence
+            // minimizes the number of passes over the pred/succ files.
+            uint64_t num_columns;
+            try {
+                num_columns = ColumnCompressed<>::read_num_labels(files[i]);
+            } catch (...) {
+                logger->error("Can't load label encoder from {}", files[i]);
+                exit(1);
+            }
+            uint64_t file_size = (utils::with_mmap() ? 0 : fs::file_size(files[i]))
+                                    + std::max(num_columns, (uint64_t)1) * MIN_ROW_DIFF_BUFFER_BYTES;
             if (with_values && !utils::with_mmap()) {
                 // also add k-mer counts
                 try {
@@ -1635,6 +1826,7 @@ void convert_to_row_diff(const std::vector<std::string> &files,
 
             mem_bytes_left -= file_size;
             file_batch.push_back(files[i]);
+            num_columns_in_batch += num_columns;
 
             // get a file name of the count vector or derive from the first file in batch
             if (construction_stage == RowDiffStage::COUNT_LABELS) {
@@ -1646,14 +1838,19 @@ void convert_to_row_diff(const std::vector<std::string> &files,
             }
         }
 
+        const uint64_t buf_size_bytes = std::min(ROW_DIFF_BUFFER_BYTES,
+                MIN_ROW_DIFF_BUFFER_BYTES
+                    + mem_bytes_left / std::max(num_columns_in_batch, (uint64_t)1));
+
         Timer timer;
-        logger->trace("Annotations in batch: {}", file_batch.size());
+        logger->trace("Annotations in batch: {}, columns: {}, buffer per column: {} KB",
+                      file_batch.size(), num_columns_in_batch, buf_size_bytes / 1000);
 
         if (construction_stage == RowDiffStage::COUNT_LABELS) {
             count_labels_per_row(file_batch, count_vector_fname, with_coordinates);
         } else {
             convert_batch_to_row_diff(graph_fname,
-                    file_batch, out_dir, swap_dir, count_vector_fname, ROW_DIFF_BUFFER_BYTES,
+                    file_batch, out_dir, swap_dir, count_vector_fname, buf_size_bytes,
                     construction_stage == RowDiffStage::COMPUTE_REDUCTION,
                     with_values, with_coordinates, num_coords_per_seq);
         }
@@ -65,7 +65,8 @@ convert_to_BRWT(const std::vector<std::string> &annotation_files,
                 size_t num_threads = 1,
                 const std::filesystem::path &tmp_dir = "");
 
-void relax_BRWT(matrix::BRWT *annotation, size_t relax_max_arity, size_t num_threads = 1);
+void relax_BRWT(matrix::BRWT *annotation, size_t relax_max_arity, size_t num_threads = 1,
+                size_t max_memory = -1);
 
 template <class StaticAnnotation>
 std::unique_ptr<StaticAnnotation>
@@ -90,6 +91,17 @@ void merge_row_compressed(const std::vector<std::string> &filenames,
 void merge_brwt(const std::vector<std::string> &filenames,
                 const std::string &outfile);
 
+// Merge row-diff annotations with disjoint labels, all transformed with the
+// same anchors and fork successors (e.g., new columns transformed against the
+// anchors of an existing index). The diffs are merged as they are, without
+// transforming the columns again. The Multi-BRWTs of RowDiffBRWTAnnotator
+// become subtrees of a new root, which can be relaxed later.
+// For RowDiffColumn/RowDiffBRWT/RowDiffDisk -Annotator
+template <class RowDiffAnnotator>
+void merge_row_diff(const std::vector<std::string> &filenames,
+                    const std::string &outfile,
+                    size_t num_threads = 1);
+
 // transform to RowCompressed<Label>
 template <typename Label>
 void convert_to_row_annotator(const ColumnCompressed<Label> &annotator,
@@ -1,7 +1,10 @@
 #include "binary_matrix.hpp"
 
+#include <numeric>
+
 #include <ips4o.hpp>
 
+#include "column_counter.hpp"
 #include "common/vectors/bitmap.hpp"
 #include "common/serialization.hpp"
 #include "common/utils/template_utils.hpp"
@@ -16,7 +19,6 @@ namespace matrix {
 
 const size_t kRowBatchSize = 10'000;
 
-
 std::vector<BinaryMatrix::SetBitPositions>
 BinaryMatrix::get_rows_dict(std::vector<Row> *rows, size_t num_threads) const {
     VectorSet<SetBitPositions, utils::VectorHash> unique_rows;
@@ -72,9 +74,7 @@ BinaryMatrix::sum_rows(const std::vector<std::pair<Row, size_t>> &index_counts,
 
     auto ic = index_counts;
 
-    // FYI: one could use tsl::hopscotch_map for counting but it is slower
-    // than std::vector unless the number of columns is ~1M or higher
-    Vector<size_t> col_counts(num_columns(), 0);
+    ColumnCounter col_counts(num_columns());
 
     // don't break the topological order for row-diff annotation
     if (!dynamic_cast<const IRowDiff *>(this))
@@ -93,21 +93,11 @@ BinaryMatrix::sum_rows(const std::vector<std::pair<Row, size_t>> &index_counts,
         const auto &rows = get_rows(ids);
 
         for (uint64_t i = begin; i < end; ++i) {
-            for (size_t j : rows[i - begin]) {
-                col_counts[j] += ic[i].second;
-            }
+            col_counts.add(rows[i - begin], ic[i].second);
         }
     }
 
-    std::vector<std::pair<Column, size_t>> result;
-    result.reserve(col_counts.size());
-
-    for (Column j = 0; j < col_counts.size(); ++j) {
-        if (col_counts[j] >= min_count)
-            result.emplace_back(j, col_counts[j]);
-    }
-
-    return result;
+    return col_counts.get(min_count);
 }
 
 
@@ -152,7 +142,7 @@ RainbowMatrix::get_rows_dict(std::vector<Row> *rows, size_t num_threads) const {
     row_codes = {};
 
     if (num_threads <= 1)
-        return codes_to_rows(codes);
+        return decode_codes(codes);
 
     std::vector<SetBitPositions> unique_rows(codes.size());
 
@@ -163,7 +153,7 @@ RainbowMatrix::get_rows_dict(std::vector<Row> *rows, size_t num_threads) const {
     for (size_t i = 0; i < codes.size(); i += batch_size) {
         std::vector<uint64_t> ids(codes.begin() + i,
                                   codes.begin() + std::min(i + batch_size, codes.size()));
-        auto rows = codes_to_rows(ids);
+        auto rows = decode_codes(ids);
         for (size_t j = 0; j < rows.size(); ++j) {
             unique_rows[i + j] = std::move(rows[j]);
         }
@@ -172,6 +162,61 @@ RainbowMatrix::get_rows_dict(std::vector<Row> *rows, size_t num_threads) const {
     return unique_rows;
 }
 
+std::vector<RainbowMatrix::SetBitPositions>
+RainbowMatrix::decode_codes(const std::vector<uint64_t> &codes) const {
+    if (!row_cache_)
+        return codes_to_rows(codes);
+
+    std::vector<SetBitPositions> rows(codes.size());
+
+    std::vector<uint64_t> missing_codes;
+    std::vector<size_t> missing_pos;
+    for (size_t i = 0; i < codes.size(); ++i) {
+        if (auto row = row_cache_->TryGet(codes[i])) {
+            rows[i] = std::move(*row);
+        } else {
+            missing_codes.push_back(codes[i]);
+            missing_pos.push_back(i);
+        }
+    }
+
+    if (missing_codes.empty())
+        return rows;
+
+    auto decoded = codes_to_rows(missing_codes);
+    for (size_t i = 0; i < decoded.size(); ++i) {
+        row_cache_->Put(missing_codes[i], decoded[i]);
+        rows[missing_pos[i]] = std::move(decoded[i]);
+    }
+
+    return rows;
+}
+
+void RainbowMatrix::set_row_cache(size_t cache_size, bool warm_up, size_t num_threads) {
+    if (!cache_size) {
+        row_cache_.reset();
+        return;
+    }
+
+    row_cache_ = std::make_shared<common::ShardedLRUCache<uint64_t, SetBitPositions>>(cache_size);
+
+    if (!warm_up)
+        return;
+
+    const uint64_t num_codes = std::min(static_cast<uint64_t>(cache_size),
+                                        num_distinct_rows());
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (uint64_t begin = 0; begin < num_codes; begin += kRowBatchSize) {
+        std::vector<uint64_t> codes(std::min(kRowBatchSize, num_codes - begin));
+        std::iota(codes.begin(), codes.end(), begin);
+        auto rows = codes_to_rows(codes);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            row_cache_->Put(codes[i], rows[i]);
+        }
+    }
+}
+
 std::vector<std::pair<RainbowMatrix::Column, size_t /* count */>>
 RainbowMatrix::sum_rows(const std::vector<std::pair<Row, size_t>> &index_counts,
                         size_t min_count) const {
@@ -196,24 +241,12 @@ RainbowMatrix::sum_rows(const std::vector<std::pair<Row, size_t>> &index_counts,
         counts[row_ids[i]] += index_counts[i].second;
     }
 
-    // FYI: one could use tsl::hopscotch_map for counting but it is slower
-    // than std::vector unless the number of columns is ~1M or higher
-    Vector<size_t> col_counts(num_columns(), 0);
+    ColumnCounter col_counts(num_columns());
     for (size_t i = 0; i < counts.size(); ++i) {
-        for (size_t j : distinct_rows[i]) {
-            col_counts[j] += counts[i];
-        }
+        col_counts.add(distinct_rows[i], counts[i]);
     }
 
-    std::vector<std::pair<Column, size_t>> result;
-    result.reserve(col_counts.size());
-
-    for (Column j = 0; j < col_counts.size(); ++j) {
-        if (col_counts[j] >= min_count)
-            result.emplace_back(j, col_counts[j]);
-    }
-
-    return result;
+    return col_counts.get(min_count);
 }
 
 
@@ -4,8 +4,10 @@
 #include <vector>
 #include <functional>
 #include <istream>
+#include <memory>
 #include <ostream>
 
+#include "common/sharded_lru_cache.hpp"
 #include "common/vector.hpp"
 
 
@@ -75,9 +77,23 @@ class RainbowMatrix : public BinaryMatrix {
 
     virtual uint64_t num_distinct_rows() const = 0;
 
+    // Cache up to |cache_size| decoded distinct rows, shared by all threads
+    // and queries. If |warm_up|, decode the rows with the smallest codes in
+    // advance, which are assigned to the most frequent rows at construction.
+    void set_row_cache(size_t cache_size, bool warm_up = false, size_t num_threads = 1);
+
+    uint64_t num_cache_hits() const { return row_cache_ ? row_cache_->num_hits() : 0; }
+    uint64_t num_cache_misses() const { return row_cache_ ? row_cache_->num_misses() : 0; }
+
   private:
     virtual uint64_t get_code(Row row) const = 0;
     virtual std::vector<SetBitPositions> codes_to_rows(const std::vector<Row> &rows) const = 0;
+
+    // same as codes_to_rows, but look up the row cache first
+    std::vector<SetBitPositions> decode_codes(const std::vector<uint64_t> &codes) const;
+
+    // shared by the copies of the matrix, since they decode to the same rows
+    std::shared_ptr<common::ShardedLRUCache<uint64_t, SetBitPositions>> row_cache_;
 };
 
 
@@ -0,0 +1,83 @@
+#ifndef __COLUMN_COUNTER_HPP__
+#define __COLUMN_COUNTER_HPP__
+
+#include <algorithm>
+#include <vector>
+
+#include <tsl/hopscotch_map.h>
+
+#include "binary_matrix.hpp"
+#include "common/utils/template_utils.hpp"
+#include "common/vector.hpp"
+
+
+namespace mtg {
+namespace annot {
+namespace matrix {
+
+// Accumulates weighted rows into column counts. The counts are stored in a
+// dense array for matrices with few columns and in a hash map otherwise, so
+// that the memory and the time spent on the final scan don't depend on the
+// total number of columns.
+class ColumnCounter {
+  public:
+    typedef BinaryMatrix::Column Column;
+
+    // FYI: tsl::hopscotch_map is slower for counting than a dense array
+    // unless the number of columns is ~1M or higher
+    static constexpr size_t kMaxDenseColumns = 1'000'000;
+
+    explicit ColumnCounter(size_t num_columns,
+                           size_t max_dense_columns = kMaxDenseColumns)
+          : dense_(num_columns <= max_dense_columns) {
+        if (dense_)
+            dense_counts_.assign(num_columns, 0);
+    }
+
+    void add(const BinaryMatrix::SetBitPositions &row, size_t count) {
+        if (dense_) {
+            size_t *counts = dense_counts_.data();
+            for (Column j : row) {
+                counts[j] += count;
+            }
+        } else {
+            for (Column j : row) {
+                sparse_counts_[j] += count;
+            }
+        }
+    }
+
+    // Return all columns with counts greater than or equal to |min_count|,
+    // sorted by column
+    std::vector<std::pair<Column, size_t>> get(size_t min_count) const {
+        std::vector<std::pair<Column, size_t>> result;
+
+        if (dense_) {
+            for (Column j = 0; j < dense_counts_.size(); ++j) {
+                if (dense_counts_[j] >= min_count)
+                    result.emplace_back(j, dense_counts_[j]);
+            }
+        } else {
+            for (const auto &[j, count] : sparse_counts_) {
+                if (count >= min_count)
+                    result.emplace_back(j, count);
+            }
+            std::sort(result.begin(), result.end(), utils::LessFirst());
+        }
+
+        return result;
+    }
+
+    bool is_dense() const { return dense_; }
+
+  private:
+    bool dense_;
+    Vector<size_t> dense_counts_;
+    tsl::hopscotch_map<Column, size_t> sparse_counts_;
+};
+
+} // namespace matrix
+} // namespace annot
+} // namespace mtg
+
+#endif // __COLUMN_COUNTER_HPP__
@@ -15,6 +15,12 @@ namespace annot {
 namespace matrix {
 
 const size_t kNumRowsInBlock = 250'000;
+// the maximum total number of set bits in the columns extracted at once by
+// call_columns, unless a single column has more
+const uint64_t kMaxNumSetBitsInBatch = 1 << 24;
+// lift rows with select queries if there are this many times fewer of them
+// than set bits in the index column, and with a single scan otherwise
+const uint64_t kMaxSelectRatio = 16;
 
 
 bool BRWT::get(Row row, Column column) const {
@@ -293,6 +299,152 @@ std::vector<BRWT::Row> BRWT::get_column(Column column) const {
     return rows;
 }
 
+void BRWT::call_columns(const std::vector<Column> &columns,
+                        const std::function<void(size_t, const bitmap&)> &callback,
+                        size_t num_threads) const {
+    // order the columns as the leaves of the tree, so that the columns
+    // extracted together share most of their ancestors
+    std::vector<std::vector<Child>> paths(columns.size());
+    // the number of set bits in each column, stored in its leaf
+    std::vector<uint64_t> num_set_bits(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        assert(columns[i] < num_columns());
+        Column column = columns[i];
+        const BRWT *node = this;
+        while (node->child_nodes_.size()) {
+            Child child = node->assignments_.group(column);
+            paths[i].push_back(child);
+            column = node->assignments_.rank(column);
+            node = node->child_nodes_[child].get();
+        }
+        num_set_bits[i] = node->nonzero_rows_->num_set_bits();
+    }
+    std::vector<size_t> order(columns.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](size_t i, size_t j) { return paths[i] < paths[j]; });
+    paths.clear();
+
+    for (size_t begin = 0; begin < order.size(); ) {
+        // bound the memory taken by the extracted positions
+        size_t end = begin + 1;
+        uint64_t batch_num_set_bits = num_set_bits[order[begin]];
+        while (end < order.size()
+                && batch_num_set_bits + num_set_bits[order[end]] <= kMaxNumSetBitsInBatch) {
+            batch_num_set_bits += num_set_bits[order[end++]];
+        }
+
+        std::vector<Column> batch(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            batch[i - begin] = columns[order[i]];
+        }
+
+        auto batch_rows = get_columns(batch, num_threads);
+
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (size_t i = begin; i < end; ++i) {
+            callback(order[i], bitmap_generator(std::move(batch_rows[i - begin]), num_rows()));
+        }
+
+        begin = end;
+    }
+}
+
+std::vector<std::vector<BRWT::Row>>
+BRWT::get_columns(const std::vector<Column> &columns, size_t num_threads) const {
+    std::vector<std::vector<Row>> result(columns.size());
+
+    auto num_nonzero_rows = nonzero_rows_->num_set_bits();
+
+    // check if the columns are empty
+    if (columns.empty() || !num_nonzero_rows)
+        return result;
+
+    // check whether it is a leaf
+    if (!child_nodes_.size()) {
+        // all columns queried in a leaf are its index column
+        result[0].reserve(num_nonzero_rows);
+        nonzero_rows_->call_ones([&](auto i) { result[0].push_back(i); });
+        for (size_t i = 1; i < result.size(); ++i) {
+            result[i] = result[0];
+        }
+        return result;
+    }
+
+    // group the columns by the child nodes
+    std::vector<std::vector<Column>> child_columns(child_nodes_.size());
+    std::vector<std::vector<size_t>> child_positions(child_nodes_.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        assert(columns[i] < num_columns());
+        auto child_node = assignments_.group(columns[i]);
+        child_columns[child_node].push_back(assignments_.rank(columns[i]));
+        child_positions[child_node].push_back(i);
+    }
+    std::vector<Child> queried_children;
+    for (size_t j = 0; j < child_nodes_.size(); ++j) {
+        if (child_columns[j].size())
+            queried_children.push_back(j);
+    }
+
+    auto query_child = [&](Child j, size_t num_threads) {
+        auto rows = child_nodes_[j]->get_columns(child_columns[j], num_threads);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            result[child_positions[j][i]] = std::move(rows[i]);
+        }
+    };
+
+    if (queried_children.size() >= num_threads) {
+        // there are enough subtrees to keep all threads busy
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (size_t j = 0; j < queried_children.size(); ++j) {
+            query_child(queried_children[j], 1);
+        }
+    } else {
+        // descend further with all threads, until there are enough subtrees
+        for (Child j : queried_children) {
+            query_child(j, num_threads);
+        }
+    }
+
+    // check if we need to update the row indexes
+    if (num_nonzero_rows < nonzero_rows_->size()) {
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (size_t i = 0; i < result.size(); ++i) {
+            lift_rows(&result[i]);
+        }
+    }
+
+    return result;
+}
+
+void BRWT::lift_rows(std::vector<Row> *rows) const {
+    assert(rows);
+    assert(std::is_sorted(rows->begin(), rows->end()));
+
+    if (rows->empty())
+        return;
+
+    if (rows->size() * kMaxSelectRatio < nonzero_rows_->num_set_bits()) {
+        for (Row &row : *rows) {
+            row = nonzero_rows_->select1(row + 1);
+        }
+        return;
+    }
+
+    // merge the positions with the set bits of the index column, scanning
+    // it from the first to the last position to lift
+    uint64_t rank = rows->front();
+    size_t k = 0;
+    nonzero_rows_->call_ones_in_range(nonzero_rows_->select1(rows->front() + 1),
+                                      nonzero_rows_->select1(rows->back() + 1) + 1,
+        [&](uint64_t i) {
+            if (rank++ == (*rows)[k])
+                (*rows)[k++] = i;
+        }
+    );
+    assert(k == rows->size());
+}
+
 bool BRWT::load(std::istream &in) {
     if (!in.good())
         return false;
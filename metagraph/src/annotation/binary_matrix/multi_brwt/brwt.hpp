@@ -30,6 +30,11 @@ class BRWT : public BinaryMatrix, public GetEntrySupport {
 
     bool get(Row row, Column column) const override;
     std::vector<Row> get_column(Column column) const override;
+    // Extract the columns of each subtree in a single traversal, sharing the
+    // index lookups in common ancestors, and in parallel over the subtrees
+    void call_columns(const std::vector<Column> &columns,
+                      const std::function<void(size_t, const bitmap&)> &callback,
+                      size_t num_threads = 1) const override;
     std::vector<SetBitPositions> get_rows(const std::vector<Row> &rows) const override;
     // query row and get ranks of each set bit in its column
     std::vector<Vector<std::pair<Column, uint64_t>>>
@@ -61,6 +66,12 @@ class BRWT : public BinaryMatrix, public GetEntrySupport {
 
     void slice_rows(Row begin, Row end, Vector<Column> *slice) const;
 
+    // get the set bit positions of each column, in parallel over the subtrees
+    std::vector<std::vector<Row>> get_columns(const std::vector<Column> &columns,
+                                              size_t num_threads = 1) const;
+    // map the sorted positions in the index column to the rows of this node
+    void lift_rows(std::vector<Row> *rows) const;
+
     // assigns columns to the child nodes
     RangePartition assignments_;
     std::unique_ptr<bit_vector> nonzero_rows_;
@@ -518,51 +518,186 @@ BRWT BRWTBottomUpBuilder::merge(std::vector<BRWT>&& nodes,
 }
 
 
-void BRWTOptimizer::relax(BRWT *brwt_matrix, uint64_t max_arity, size_t num_threads) {
+template <class T>
+static T* as_pointer(T &node) { return &node; }
+
+template <class T>
+static T* as_pointer(const std::unique_ptr<T> &node) { return node.get(); }
+
+// group the internal nodes by depth, the root first
+template <class Node, class GetChildren>
+static std::vector<std::vector<Node *>> get_levels(Node *root, const GetChildren &get_children) {
+    std::vector<std::vector<Node *>> levels;
+    if (get_children(*root).size())
+        levels.push_back({ root });
+
+    while (levels.size() && levels.back().size()) {
+        std::vector<Node *> next_level;
+        for (Node *parent : levels.back()) {
+            for (auto &child : get_children(*parent)) {
+                if (get_children(*as_pointer(child)).size())
+                    next_level.push_back(as_pointer(child));
+            }
+        }
+        levels.push_back(std::move(next_level));
+    }
+    if (levels.size())
+        levels.pop_back();
+
+    return levels;
+}
+
+struct TreeStats {
+    uint64_t num_nodes = 0;
+    uint64_t max_depth = 0;
+    double avg_leaf_depth = 0;
+    double size = 0;
+};
+
+template <class Shape>
+static TreeStats get_stats(const Shape &root) {
+    TreeStats stats;
+    uint64_t num_leaves = 0;
+    std::function<void(const Shape &, uint64_t)> visit = [&](const Shape &node, uint64_t depth) {
+        stats.num_nodes++;
+        stats.size += bit_vector_smallrank::predict_size(node.size, node.num_set_bits);
+        if (node.children.empty()) {
+            num_leaves++;
+            stats.avg_leaf_depth += depth;
+            stats.max_depth = std::max(stats.max_depth, depth);
+        }
+        for (const auto &child : node.children) {
+            visit(child, depth + 1);
+        }
+    };
+    visit(root, 0);
+    stats.avg_leaf_depth /= std::max(num_leaves, uint64_t(1));
+    return stats;
+}
+
+BRWTOptimizer::Shape BRWTOptimizer::get_shape(const BRWT &node) {
+    Shape shape { &node, node.nonzero_rows_->size(), node.nonzero_rows_->num_set_bits(), {} };
+    shape.children.reserve(node.child_nodes_.size());
+    for (const auto &child : node.child_nodes_) {
+        shape.children.push_back(get_shape(*child));
+    }
+    return shape;
+}
+
+void BRWTOptimizer::relax(BRWT *brwt_matrix, uint64_t max_arity, size_t num_threads,
+                          size_t max_memory) {
     assert(brwt_matrix);
 
-    std::deque<BRWT*> parents;
+    // Plan the relaxation on the sizes of the index vectors only. When a node
+    // is removed, the index vectors of its children are expanded to the size
+    // of its own index vector, which is all that later decisions depend on.
+    Shape shape = get_shape(*brwt_matrix);
+    const TreeStats stats_before = get_stats(shape);
+
+    auto shape_levels = get_levels(&shape, [](Shape &node) -> auto& {
+        return node.children;
+    });
+
+    std::unordered_map<const BRWT *, uint64_t> to_prune;
 
-    // traverse the tree and collect the nodes
     // order: leaves first, root last
-    brwt_matrix->BFT([&](const BRWT &node) {
-        if (node.child_nodes_.size())
-            parents.push_front(const_cast<BRWT*>(&node));
+    for (auto level = shape_levels.rbegin(); level != shape_levels.rend(); ++level) {
+        for (Shape *parent : *level) {
+            for (int g = parent->children.size() - 1; g >= 0; --g) {
+                Shape &node = parent->children[g];
+
+                if (should_prune(node)
+                        && parent->children.size() - 1 + node.children.size() <= max_arity) {
+                    // the size of the index column to expand the children with
+                    to_prune.emplace(node.node, node.size);
+
+                    std::vector<Shape> grand_children = std::move(node.children);
+                    const uint64_t size = node.size;
+                    parent->children.erase(parent->children.begin() + g);
+                    for (auto &grand_child : grand_children) {
+                        grand_child.size = size;
+                        parent->children.push_back(std::move(grand_child));
+                    }
+                }
+            }
+        }
+    }
+
+    const TreeStats stats_after = get_stats(shape);
+    shape_levels.clear();
+    shape = Shape();
+
+    logger->info("Relaxing Multi-BRWT: removing {} of {} nodes, average leaf depth"
+                 " {:.2f} -> {:.2f}, max depth {} -> {}, size {:.2f} -> {:.2f} MB",
+                 to_prune.size(), stats_before.num_nodes,
+                 stats_before.avg_leaf_depth, stats_after.avg_leaf_depth,
+                 stats_before.max_depth, stats_after.max_depth,
+                 stats_before.size / 8e6, stats_after.size / 8e6);
+
+    if (to_prune.empty())
+        return;
+
+    // Remove the planned nodes in the same order. The nodes at the same depth
+    // have disjoint subtrees, so they are processed concurrently.
+    auto levels = get_levels(brwt_matrix, [](const BRWT &node) -> const auto& {
+        return node.child_nodes_;
     });
 
-    ProgressBar progress_bar(parents.size(), "Relax Multi-BRWT",
+    ProgressBar progress_bar(to_prune.size(), "Relax Multi-BRWT",
                              std::cerr, !common::get_verbose());
 
-    for (BRWT *parent : parents) {
-        assert(parent->child_nodes_.size());
-
+    auto relax_node = [&](BRWT *parent, size_t num_threads) {
         for (int g = parent->child_nodes_.size() - 1; g >= 0; --g) {
-            const auto *node = dynamic_cast<const BRWT*>(parent->child_nodes_[g].get());
-
-            if (node && should_prune(*node)
-                     && parent->child_nodes_.size() - 1
-                            + node->child_nodes_.size() <= max_arity) {
+            if (to_prune.count(parent->child_nodes_[g].get())) {
                 // remove this node and reassign all its children directly to its parent
                 reassign(g, parent, num_threads);
+                ++progress_bar;
             }
         }
+    };
 
-        ++progress_bar;
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+        // each removed node takes an uncompressed copy of its index vector
+        // plus one more for each thread expanding the index vectors of its children
+        std::vector<BRWT *> parents;
+        uint64_t max_bytes = 0;
+        for (BRWT *parent : *level) {
+            uint64_t bytes = 0;
+            for (const auto &child : parent->child_nodes_) {
+                auto it = to_prune.find(child.get());
+                if (it != to_prune.end())
+                    bytes = std::max(bytes, (it->second + 7) / 8);
+            }
+            if (bytes) {
+                parents.push_back(parent);
+                max_bytes = std::max(max_bytes, bytes);
+            }
+        }
+
+        if (parents.empty())
+            continue;
+
+        const size_t max_copies = std::max(max_memory / max_bytes, size_t(2));
+
+        size_t num_parallel = std::min({ parents.size(), num_threads, max_copies / 2 });
+        if (num_parallel > 1) {
+            #pragma omp parallel for num_threads(num_parallel) schedule(dynamic)
+            for (size_t i = 0; i < parents.size(); ++i) {
+                relax_node(parents[i], 1);
+            }
+        } else {
+            for (BRWT *parent : parents) {
+                relax_node(parent, std::min(num_threads, max_copies - 1));
+            }
+        }
     }
 }
 
-bool BRWTOptimizer::should_prune(const BRWT &node) {
+bool BRWTOptimizer::should_prune(const Shape &node) {
     // we don't remove leaves in BRWT
-    if (!node.child_nodes_.size())
+    if (!node.children.size())
         return false;
 
-    // we relax only those child nodes, that have only BRWT nodes
-    // because nodes of other types can't be reassigned
-    for (const auto &child_node : node.child_nodes_) {
-        if (!dynamic_cast<const BRWT *>(child_node.get()))
-            return false;
-    }
-
     // we don't remove nodes if it doesn't reduce the size
     return pruning_delta(node) <= 0;
 }
@@ -644,33 +779,23 @@ void BRWTOptimizer::reassign(size_t node_rank, BRWT *parent, size_t num_threads)
     }
 }
 
-double BRWTOptimizer::pruning_delta(const BRWT &node) {
-    assert(node.child_nodes_.size());
+double BRWTOptimizer::pruning_delta(const Shape &node) {
+    assert(node.children.size());
 
     double delta = 0;
 
-    for (const auto &submatrix : node.child_nodes_) {
-        auto *brwt_child = dynamic_cast<const BRWT*>(submatrix.get());
-        assert(brwt_child);
-
-        assert(brwt_child->num_rows() <= node.num_rows());
-        assert(brwt_child->nonzero_rows_->size() <= node.num_rows());
+    for (const auto &child : node.children) {
+        assert(child.size <= node.size);
 
         // updated vector
-        delta += bit_vector_smallrank::predict_size(
-                        node.num_rows(),
-                        brwt_child->nonzero_rows_->num_set_bits());
+        delta += bit_vector_smallrank::predict_size(node.size, child.num_set_bits);
 
         // old index vector
-        delta -= bit_vector_smallrank::predict_size(
-                        brwt_child->nonzero_rows_->size(),
-                        brwt_child->nonzero_rows_->num_set_bits());
+        delta -= bit_vector_smallrank::predict_size(child.size, child.num_set_bits);
     }
 
     // removed index vector
-    delta -= bit_vector_smallrank::predict_size(
-                    node.nonzero_rows_->size(),
-                    node.nonzero_rows_->num_set_bits());
+    delta -= bit_vector_smallrank::predict_size(node.size, node.num_set_bits);
 
     return delta;
 }
@@ -62,16 +62,29 @@ class BRWTOptimizer {
 
     // remove some internal nodes to make the tree
     // smaller and increase the arity
+    // The nodes to remove are planned first, and then the nodes at the same
+    // depth are relaxed in parallel, while the index vectors being rebuilt
+    // take at most |max_memory| bytes (or as little as possible if less).
     static void relax(BRWT *brwt_matrix,
                       uint64_t max_arity = -1,
-                      size_t num_threads = 1);
+                      size_t num_threads = 1,
+                      size_t max_memory = -1);
   private:
+    // the sizes of the index vectors in a subtree, enough to plan the relaxation
+    struct Shape {
+        const BRWT *node;
+        uint64_t size;
+        uint64_t num_set_bits;
+        std::vector<Shape> children;
+    };
+
+    static Shape get_shape(const BRWT &node);
     // check if removing this node is going to reduce the size
-    static bool should_prune(const BRWT &node);
+    static bool should_prune(const Shape &node);
     // remove the node and reassign all its children to its parent
     static void reassign(size_t node_rank, BRWT *parent, size_t num_threads);
     // estimate delta between the transformed tree and the current one
-    static double pruning_delta(const BRWT &node);
+    static double pruning_delta(const Shape &node);
 };
 
 } // namespace matrix
@@ -39,6 +39,23 @@ BinaryMatrix::SetBitPositions RowDisk::View::get_row(Row row) const {
     return result;
 }
 
+void RowDisk::View::call_rows(Row begin, Row end, const RowCallback &callback) const {
+    assert(begin <= end);
+    assert(end <= boundary_.num_set_bits());
+    SetBitPositions result;
+    uint64_t row_begin = begin == 0 ? 0 : boundary_.select1(begin) + 1;
+    for (Row row = begin; row < end; ++row) {
+        uint64_t row_end = boundary_.select1(row + 1);
+        result.clear();
+        uint64_t last = 0;
+        for (uint64_t i = row_begin; i != row_end; ++i) {
+            result.push_back(last += set_bits_[i - row]);
+        }
+        callback(result);
+        row_begin = row_end + 1;
+    }
+}
+
 bool RowDisk::load(std::istream &f) {
     auto _f = dynamic_cast<sdsl::mmap_ifstream *>(&f);
     assert(_f);
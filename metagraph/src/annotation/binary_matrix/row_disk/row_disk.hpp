@@ -24,6 +24,12 @@ class RowDisk : public RowMajor {
     // FYI: `get_column` is very inefficient, consider using column-major formats
     std::vector<Row> get_column(Column j) const { return get_view().get_column(j); }
 
+    // Call the rows [begin, end) in order. Unlike get_row, which opens the
+    // file for each row, this reads all of them through a single buffer.
+    void call_rows(Row begin, Row end, const RowCallback &callback) const {
+        get_view().call_rows(begin, end, callback);
+    }
+
     bool load(std::istream &in);
     void serialize(std::ostream &out) const;
 
@@ -52,6 +58,7 @@ class RowDisk : public RowMajor {
 
         SetBitPositions get_row(Row i) const;
         std::vector<Row> get_column(Column j) const;
+        void call_rows(Row begin, Row end, const RowCallback &callback) const;
 
       private:
         const bit_vector_small &boundary_;
@@ -52,9 +52,9 @@ template <class BinaryMatrixType, typename Label>
 LabelEncoder<Label>
 StaticBinRelAnnotator<BinaryMatrixType, Label>::read_label_encoder(const std::string &filename) {
     const auto &fname = make_suffix(filename, kExtension);
-    std::ifstream in(fname, std::ios::binary);
+    std::unique_ptr<std::ifstream> in = utils::open_ifstream(fname);
     LabelEncoder<Label> label_encoder;
-    if (!label_encoder.load(in))
+    if (!label_encoder.load(*in))
         throw std::ofstream::failure("Can't load label encoder from " + fname);
     return label_encoder;
 }
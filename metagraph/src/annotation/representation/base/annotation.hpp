@@ -89,6 +89,8 @@ class MultiLabelAnnotation {
 template <typename Label>
 class LabelEncoder {
   public:
+    static constexpr size_t npos = -1;
+
     /**
      * If the label passed does not exist, insert
      * that label and return its code.
@@ -106,6 +108,14 @@ class LabelEncoder {
      */
     bool label_exists(const Label &label) const { return encode_label_.count(label); }
 
+    /**
+     * Return the code of the label passed or npos if it does not exist.
+     */
+    size_t find(const Label &label) const {
+        auto it = encode_label_.find(label);
+        return it != encode_label_.end() ? it->second : npos;
+    }
+
     /**
      * Throws an exception if a bad code is passed.
      */
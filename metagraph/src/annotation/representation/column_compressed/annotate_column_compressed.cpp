@@ -84,10 +84,29 @@ ColumnCompressed<Label>::~ColumnCompressed() {
     cached_columns_.Clear();
 }
 
+// thread-safe
 template <typename Label>
 void ColumnCompressed<Label>::add_labels(const std::vector<Index> &indices,
                                          const VLabels &labels) {
     for (const auto &label : labels) {
+        {
+            // Fast path: the column builder is already in cache and can be
+            // updated concurrently. The shared lock guarantees that the builder
+            // isn't evicted and flushed while the positions are being inserted.
+            std::shared_lock<std::shared_mutex> lock(builders_mu_);
+            if (label_encoder_.label_exists(label)) {
+                if (auto cached = cached_columns_.TryGet(label_encoder_.encode(label))) {
+                    // uncompressed columns (bitmap_vector) are not thread-safe
+                    if (!dynamic_cast<bitmap_dyn*>(*cached)) {
+                        (*cached)->add_ones(indices.data(), indices.data() + indices.size());
+                        continue;
+                    }
+                }
+            }
+        }
+        // Slow path: a new label, or the column has to be decompressed, or
+        // another column has to be evicted from cache.
+        std::unique_lock<std::shared_mutex> lock(builders_mu_);
         const auto j = label_encoder_.insert_and_encode(label);
         decompress_builder(j).add_ones(indices.data(),
                                        indices.data() + indices.size());
@@ -140,6 +159,9 @@ void ColumnCompressed<Label>::add_label_counts(const std::vector<Index> &indices
 // for each label and index 'i' add numeric attribute 'coord'
 template <typename Label>
 void ColumnCompressed<Label>::add_label_coord(Index i, const VLabels &labels, uint64_t coord) {
+    // the label encoder may be extended by concurrent calls of add_labels
+    std::shared_lock<std::shared_mutex> lock(builders_mu_);
+
     while (coords_.size() < num_labels()) {
         coords_.emplace_back(get_num_threads(),
                              buffer_size_bytes_ / sizeof(std::pair<Index, uint64_t>),
@@ -158,6 +180,9 @@ void ColumnCompressed<Label>::add_label_coord(Index i, const VLabels &labels, ui
 template <typename Label>
 void ColumnCompressed<Label>::add_label_coords(const std::vector<std::pair<Index, uint64_t>> &coords,
                                                const VLabels &labels) {
+    // the label encoder may be extended by concurrent calls of add_labels
+    std::shared_lock<std::shared_mutex> lock(builders_mu_);
+
     while (coords_.size() < num_labels()) {
         coords_.emplace_back(get_num_threads(),
                              buffer_size_bytes_ / sizeof(std::pair<Index, uint64_t>),
@@ -545,10 +570,10 @@ template <typename Label>
 LabelEncoder<Label>
 ColumnCompressed<Label>::read_label_encoder(const std::string &filename) {
     auto fname = make_suffix(filename, kExtension);
-    std::ifstream in(filename, std::ios::binary);
-    std::ignore = load_number(in); // read num_rows
+    std::unique_ptr<std::ifstream> in = utils::open_ifstream(fname);
+    std::ignore = load_number(*in); // read num_rows
     LabelEncoder<Label> label_encoder;
-    if (!label_encoder.load(in))
+    if (!label_encoder.load(*in))
         throw std::ofstream::failure("Can't load label encoder from " + fname);
     return label_encoder;
 }
@@ -2,6 +2,7 @@
 #define __ANNOTATE_COLUMN_COMPRESSED_HPP__
 
 #include <mutex>
+#include <shared_mutex>
 
 #include <cache.hpp>
 #include <lru_cache_policy.hpp>
@@ -19,8 +20,11 @@ namespace annot {
 
 /**
  * Multithreading:
- *  The non-const methods must be called sequentially (except add_label_counts).
- *  Then, any subset of the public const methods can be called concurrently.
+ *  The non-const methods must be called sequentially (except add_labels and
+ *  add_label_counts). Then, any subset of the public const methods can be
+ *  called concurrently.
+ *  add_labels inserts into the shared column builders (there are no per-thread
+ *  builders), so it only scales while the columns being updated stay in cache.
  */
 template <typename Label = std::string>
 class ColumnCompressed : public MultiLabelAnnotation<Label> {
@@ -60,6 +64,8 @@ class ColumnCompressed : public MultiLabelAnnotation<Label> {
 
     ~ColumnCompressed();
 
+    // thread-safe, the positions are inserted into the column builders
+    // concurrently unless a new column must be created or decompressed
     void add_labels(const std::vector<Index> &indices,
                     const VLabels &labels) override;
     // for each label and index 'indices[i]' add count 'counts[i]'
@@ -170,6 +176,8 @@ class ColumnCompressed : public MultiLabelAnnotation<Label> {
     caches::fixed_sized_cache<size_t,
                               bitmap_builder*,
                               caches::LRUCachePolicy<size_t>> cached_columns_;
+    // shared for inserting into cached builders, exclusive for modifying the cache
+    std::shared_mutex builders_mu_;
 
     mutable std::mutex counts_mu_;
     uint8_t count_width_;
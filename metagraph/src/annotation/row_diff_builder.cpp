@@ -448,6 +448,83 @@ void row_diff_traverse(const graph::DeBruijnGraph &graph,
     }
 }
 
+/**
+ * Concatenate chunks of int vectors, stored in separate files, in a single file.
+ * The packed words of the chunks are copied directly (shifted to the current
+ * bit offset), without decoding the individual integers.
+ * @param num_chunks number of chunks
+ * @param get_chunk_fname file name of the i-th chunk
+ * @param out_fname file name of the concatenated vector
+ * @param width width of the integers stored in the chunks
+ */
+template <uint8_t t_width = 0>
+void concat_chunks(uint64_t num_chunks,
+                   const std::function<std::string(uint64_t)> &get_chunk_fname,
+                   const std::string &out_fname,
+                   uint32_t width) {
+    typedef sdsl::int_vector<t_width> vector_type;
+    typename vector_type::size_type num_bits = 0;
+    typename vector_type::size_type chunk_bits;
+    typename vector_type::int_width_type chunk_width;
+    for (uint64_t c = 0; c < num_chunks; ++c) {
+        std::ifstream in(get_chunk_fname(c), std::ios::binary);
+        vector_type::read_header(chunk_bits, chunk_width, in);
+        if (!in.good() || (t_width == 0 && chunk_width != width)) {
+            logger->error("Failed to read chunk {}", get_chunk_fname(c));
+            exit(1);
+        }
+        num_bits += chunk_bits;
+    }
+
+    std::ofstream out(out_fname, std::ios::binary);
+    vector_type::write_header(num_bits, width, out);
+
+    std::vector<uint64_t> in_buf(BUFFER_SIZE / sizeof(uint64_t));
+    std::vector<uint64_t> out_buf;
+    out_buf.reserve(in_buf.size() + 1);
+    // the lower |carry_bits| bits of |carry| are yet to be written
+    uint64_t carry = 0;
+    uint32_t carry_bits = 0;
+    for (uint64_t c = 0; c < num_chunks; ++c) {
+        std::ifstream in(get_chunk_fname(c), std::ios::binary);
+        vector_type::read_header(chunk_bits, chunk_width, in);
+        for (uint64_t words_left = (chunk_bits + 63) / 64; words_left; ) {
+            const uint64_t num_words = std::min(words_left, (uint64_t)in_buf.size());
+            if (!in.read(reinterpret_cast<char *>(in_buf.data()), num_words * sizeof(uint64_t))) {
+                logger->error("Failed to read chunk {}", get_chunk_fname(c));
+                exit(1);
+            }
+            words_left -= num_words;
+            for (uint64_t i = 0; i < num_words; ++i) {
+                uint64_t word = in_buf[i];
+                uint32_t word_bits = 64;
+                if (!words_left && i + 1 == num_words && chunk_bits % 64) {
+                    word_bits = chunk_bits % 64;
+                    word &= sdsl::bits::lo_set[word_bits];
+                }
+                carry |= word << carry_bits;
+                if (carry_bits + word_bits >= 64) {
+                    out_buf.push_back(carry);
+                    carry = carry_bits ? word >> (64 - carry_bits) : 0;
+                    carry_bits = carry_bits + word_bits - 64;
+                } else {
+                    carry_bits += word_bits;
+                }
+            }
+            out.write(reinterpret_cast<const char *>(out_buf.data()),
+                      out_buf.size() * sizeof(uint64_t));
+            out_buf.clear();
+        }
+    }
+    if (carry_bits)
+        out.write(reinterpret_cast<const char *>(&carry), sizeof(uint64_t));
+
+    if (!out.good()) {
+        logger->error("Failed to write {}", out_fname);
+        exit(1);
+    }
+}
+
 void build_pred_succ(const graph::DeBruijnGraph &graph,
                      const std::string &outfbase,
                      const std::string &count_vectors_dir,
@@ -470,13 +547,6 @@ void build_pred_succ(const graph::DeBruijnGraph &graph,
                                       count_vectors_dir, row_count_extension);
     auto& rd_succ = *rd_succ_ptr;
 
-    // create the succ/pred files, indexed using annotation indices
-    uint32_t width = sdsl::bits::hi(graph.max_index()) + 1;
-    sdsl::int_vector_buffer<> succ(outfbase + ".succ", std::ios::out, BUFFER_SIZE, width);
-    sdsl::int_vector_buffer<1> succ_boundary(outfbase + ".succ_boundary", std::ios::out, BUFFER_SIZE);
-    sdsl::int_vector_buffer<> pred(outfbase + ".pred", std::ios::out, BUFFER_SIZE, width);
-    sdsl::int_vector_buffer<1> pred_boundary(outfbase + ".pred_boundary", std::ios::out, BUFFER_SIZE);
-
     std::optional<sdsl::bit_vector> dummy;
     auto* succinct = dynamic_cast<graph::DBGSuccinct const*>(&graph);
     if (succinct) {
@@ -486,17 +556,35 @@ void build_pred_succ(const graph::DeBruijnGraph &graph,
     ProgressBar progress_bar(graph.max_index(), "Compute succ/pred", std::cerr,
                              !common::get_verbose());
 
+    // The nodes are split into contiguous chunks, each written by a single
+    // thread to its own files. The chunks are concatenated in order at the end,
+    // so the threads never wait for each other to append to the output files.
     const uint64_t BS = 1'000'000;
-    // traverse graph in parallel processing blocks of size |BS|
-    // use static scheduling to make threads process ordered contiguous blocks
-    #pragma omp parallel for ordered num_threads(num_threads) schedule(dynamic)
-    for (node_index start = 1; start <= graph.max_index(); start += BS) {
-        std::vector<node_index> succ_buf;
-        std::vector<bool> succ_boundary_buf;
-        std::vector<node_index> pred_buf;
-        std::vector<bool> pred_boundary_buf;
-
-        for (node_index i = start; i < std::min(start + BS, graph.max_index() + 1); ++i) {
+    const uint64_t num_blocks = (graph.max_index() + BS - 1) / BS;
+    const uint64_t num_chunks = std::max(std::min(num_blocks, (uint64_t)num_threads * 4),
+                                         (uint64_t)1);
+    const uint64_t chunk_size = (num_blocks + num_chunks - 1) / num_chunks * BS;
+
+    uint32_t width = sdsl::bits::hi(graph.max_index()) + 1;
+    const fs::path tmp_dir = utils::create_temp_dir(utils::get_swap_path(), "pred_succ");
+    auto chunk_fname = [&](uint64_t c, const std::string &suffix) {
+        return tmp_dir/fmt::format("chunk_{}{}", c, suffix);
+    };
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (uint64_t c = 0; c < num_chunks; ++c) {
+        sdsl::int_vector_buffer<> succ(chunk_fname(c, ".succ"),
+                                       std::ios::out, BUFFER_SIZE, width);
+        sdsl::int_vector_buffer<1> succ_boundary(chunk_fname(c, ".succ_boundary"),
+                                                 std::ios::out, BUFFER_SIZE);
+        sdsl::int_vector_buffer<> pred(chunk_fname(c, ".pred"),
+                                       std::ios::out, BUFFER_SIZE, width);
+        sdsl::int_vector_buffer<1> pred_boundary(chunk_fname(c, ".pred_boundary"),
+                                                 std::ios::out, BUFFER_SIZE);
+
+        const node_index begin = 1 + c * chunk_size;
+        const node_index end = std::min(begin + chunk_size, graph.max_index() + 1);
+        for (node_index i = begin; i < end; ++i) {
             bool skip_succ = false;
             bool skip_all = !graph.in_graph(i);
 
@@ -513,36 +601,46 @@ void build_pred_succ(const graph::DeBruijnGraph &graph,
                 skip_succ |= graph.has_no_outgoing(i);
                 if (!skip_succ) {
                     auto j = row_diff_successor(graph, i, rd_succ);
-                    succ_buf.push_back(to_row(j));
-                    succ_boundary_buf.push_back(0);
+                    succ.push_back(to_row(j));
+                    succ_boundary.push_back(0);
                 }
 
                 if (rd_succ[i]) {
-                    graph.adjacent_incoming_nodes(i, [&](auto pred) {
-                        if (dummy && (*dummy)[pred]) {
+                    graph.adjacent_incoming_nodes(i, [&](auto pred_node) {
+                        if (dummy && (*dummy)[pred_node]) {
                             return;
                         }
-                        pred_buf.push_back(to_row(pred));
-                        pred_boundary_buf.push_back(0);
+                        pred.push_back(to_row(pred_node));
+                        pred_boundary.push_back(0);
                     });
                 }
             }
 
-            succ_boundary_buf.push_back(1);
-            pred_boundary_buf.push_back(1);
+            succ_boundary.push_back(1);
+            pred_boundary.push_back(1);
             ++progress_bar;
         }
+    }
 
-        #pragma omp ordered
-        {
-            // append to the files on disk
-            for (uint64_t v : succ_buf) { succ.push_back(v); }
-            for (bool v : succ_boundary_buf) { succ_boundary.push_back(v); }
-            for (uint64_t v : pred_buf) { pred.push_back(v); }
-            for (bool v : pred_boundary_buf) { pred_boundary.push_back(v); }
-        }
+    // concatenate the chunks, all four output files are written in parallel
+    #pragma omp parallel sections num_threads(std::min(num_threads, 4u))
+    {
+        #pragma omp section
+        concat_chunks<>(num_chunks, [&](uint64_t c) { return chunk_fname(c, ".succ"); },
+                        outfbase + ".succ", width);
+        #pragma omp section
+        concat_chunks<1>(num_chunks, [&](uint64_t c) { return chunk_fname(c, ".succ_boundary"); },
+                         outfbase + ".succ_boundary", 1);
+        #pragma omp section
+        concat_chunks<>(num_chunks, [&](uint64_t c) { return chunk_fname(c, ".pred"); },
+                        outfbase + ".pred", width);
+        #pragma omp section
+        concat_chunks<1>(num_chunks, [&](uint64_t c) { return chunk_fname(c, ".pred_boundary"); },
+                         outfbase + ".pred_boundary", 1);
     }
 
+    utils::remove_temp_dir(tmp_dir);
+
     logger->trace("Pred/succ nodes written to {}.pred/succ", outfbase);
 }
 
@@ -620,12 +718,12 @@ void assign_anchors(const graph::DeBruijnGraph &graph,
     // anchors_bv uses BOSS edges as indices, so we need to map it to annotation indices
     {
         sdsl::bit_vector anchors(num_rows, false);
-        for (BOSS::edge_index i = 1; i < anchors_bv.size(); ++i) {
-            if (anchors_bv[i]) {
-                uint64_t graph_idx = i;
-                assert(to_row(graph_idx) < num_rows);
-                anchors[to_row(graph_idx)] = 1;
-            }
+        assert(anchors_bv.size() == num_rows + 1);
+        // each thread fills its own words of |anchors|, so no synchronization is needed
+        #pragma omp parallel for num_threads(num_threads) schedule(static)
+        for (uint64_t i = 0; i < num_rows; i += 64) {
+            uint8_t len = std::min(num_rows - i, (uint64_t)64);
+            anchors.set_int(i, anchors_bv.get_int(to_node(i), len), len);
         }
         anchors_bv = std::move(anchors);
     }
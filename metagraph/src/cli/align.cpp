@@ -25,11 +25,6 @@ using namespace mtg::graph::align;
 using mtg::seq_io::kseq_t;
 using mtg::common::logger;
 
-// after how many threads should per-thread traversal caches be used instead of
-// a single shared cache
-const size_t SEPARATE_CACHES_SWITCHOVER_THREADS = 8;
-
-
 DBGAlignerConfig initialize_aligner_config(const Config &config,
                                            const DeBruijnGraph &graph) {
     assert(config.alignment_num_alternative_paths);
@@ -367,9 +362,8 @@ int align_to_graph(Config *config) {
         return graph;
     };
 
-    // if using a small number of threads, use a shared cache for all threads
-    if (get_num_threads() <= SEPARATE_CACHES_SWITCHOVER_THREADS)
-        graph = wrap_graph(graph);
+    // the caches are thread-safe, so they are shared by all threads
+    graph = wrap_graph(graph);
 
     timer.reset();
 
@@ -411,24 +405,13 @@ int align_to_graph(Config *config) {
             }
 
             thread_pool.enqueue([&,graph,batch=std::move(seq_batch)]() {
-                // Make a dummy shared_ptr
-                auto aln_graph
-                    = std::shared_ptr<DeBruijnGraph>(std::shared_ptr<DeBruijnGraph>{}, graph.get());
-
-                // Give each thread a separate cache if using many threads to avoid
-                // contention
-                if (aln_graph->get_mode() == DeBruijnGraph::PRIMARY) {
-                    assert(get_num_threads() > SEPARATE_CACHES_SWITCHOVER_THREADS);
-                    aln_graph = wrap_graph(aln_graph);
-                }
-
                 std::unique_ptr<IDBGAligner> aligner;
 
                 if (anno_dbg) {
-                    aligner = std::make_unique<LabeledAligner<>>(*aln_graph, aligner_config,
+                    aligner = std::make_unique<LabeledAligner<>>(*graph, aligner_config,
                                                                  anno_dbg->get_annotator());
                 } else {
-                    aligner = std::make_unique<DBGAligner<>>(*aln_graph, aligner_config);
+                    aligner = std::make_unique<DBGAligner<>>(*graph, aligner_config);
                 }
 
                 aligner->align_batch(batch,
@@ -35,6 +35,19 @@ void push_sequences(const std::vector<std::string> &files,
                     GraphConstructor *constructor) {
     #pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 1)
     for (size_t i = 0; i < files.size(); ++i) {
+        if constexpr(std::is_same_v<GraphConstructor, boss::IBOSSChunkConstructor>) {
+            // pass the k-mers from KMC databases to the k-mer collector directly,
+            // without decoding them to strings and encoding back
+            if (file_format(files[i]) == "KMC" && !config.forward_and_reverse) {
+                parse_kmc_kmers_packed(files[i], config,
+                    [constructor](size_t k, auto&& kmers, auto&& counts) {
+                        constructor->add_packed_kmers(k, std::move(kmers), std::move(counts));
+                    }
+                );
+                continue;
+            }
+        }
+
         BatchAccumulator<std::pair<std::string, uint64_t>> batcher(
             [constructor](auto&& sequences) {
                 constructor->add_sequences(std::move(sequences));
@@ -251,10 +264,29 @@ int build_graph(Config *config) {
         }
 
     } else if (config->graph_type == Config::GraphType::SSHASH && !config->dynamic) {
-        graph.reset(new DBGSSHash(files.at(0), config->k, config->graph_mode, config->num_chars));
-        if (files.size() > 1) {
-            logger->error("DBGSSHash does not support multiple input files.");
-            exit(1);
+        if (files.size() == 1 && file_format(files[0]) == "FASTA"
+                && !config->forward_and_reverse) {
+            // the SSHash builder parses a single FASTA file by itself
+            graph.reset(new DBGSSHash(files[0], config->k, config->graph_mode,
+                                      config->num_chars));
+        } else {
+            // The SSHash builder requires each k-mer to occur in its input only
+            // once, while reads from several files, FASTQ, or KMC overlap.
+            // Hence, collect the distinct k-mers in a temporary hash graph first
+            // and then build the SSHash graph from its unitigs.
+            DBGHashFast hash_graph(config->k,
+                                   config->graph_mode == DeBruijnGraph::BASIC
+                                       ? DeBruijnGraph::BASIC
+                                       : DeBruijnGraph::CANONICAL);
+            for (const auto &file : files) {
+                parse_sequences_and_log(file, *config, config->k,
+                    [&](std::string_view seq, uint32_t) { hash_graph.add_sequence(seq); }
+                );
+            }
+            logger->trace("Collected {} distinct k-mers in {} sec",
+                          hash_graph.num_nodes(), timer.elapsed());
+
+            graph.reset(new DBGSSHash(hash_graph, get_num_threads(), config->tmp_dir));
         }
 
     } else {
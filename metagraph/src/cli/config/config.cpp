@@ -1,6 +1,7 @@
 #include "config.hpp"
 
 #include <cstring>
+#include <optional>
 #include <iostream>
 #include <unordered_set>
 #include <filesystem>
@@ -72,6 +73,7 @@ Config::Config(int argc, char *argv[]) {
         identity = ASSEMBLE;
     } else if (!strcmp(argv[1], "relax_brwt")) {
         identity = RELAX_BRWT;
+        memory_available = 1000; // 1 TB
     } else if (!strcmp(argv[1], "--version")) {
         std::cout << "Version: " VERSION << std::endl;
         exit(0);
@@ -110,13 +112,17 @@ Config::Config(int argc, char *argv[]) {
 
     bool print_usage_and_exit = false;
     bool xdrop_override = false;
+    // resolved once all arguments are parsed, see below
+    std::optional<bool> use_mmap;
 
     // parse remaining command line items
     for (int i = 2; i < argc; ++i) {
         if (!strcmp(argv[i], "-v") || !strcmp(argv[i], "--verbose")) {
             common::set_verbose(true);
         } else if (!strcmp(argv[i], "--mmap")) {
-            utils::with_mmap(true);
+            use_mmap = true;
+        } else if (!strcmp(argv[i], "--no-mmap")) {
+            use_mmap = false;
         } else if (!strcmp(argv[i], "--print")) {
             print_graph = true;
         } else if (!strcmp(argv[i], "--advanced")) {
@@ -395,8 +401,10 @@ Config::Config(int argc, char *argv[]) {
             relax_arity_brwt = atoi(get_value(i++));
         } else if (!strcmp(argv[i], "--RA-ivbuff-size")) {
             RA_ivbuffer_size = atoll(get_value(i++));
-        // } else if (!strcmp(argv[i], "--cache-size")) {
-        //     row_cache_size = atoi(get_value(i++));
+        } else if (!strcmp(argv[i], "--cache-size")) {
+            row_cache_size = atoll(get_value(i++));
+        } else if (!strcmp(argv[i], "--warm-up-cache")) {
+            warm_up_row_cache = true;
         } else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
             print_welcome_message();
             print_usage(argv[0], identity);
@@ -628,6 +636,12 @@ Config::Config(int argc, char *argv[]) {
         }
     }
 
+    // the server maps its indexes unless --no-mmap is passed
+    if (identity == SERVER_QUERY && !use_mmap.has_value())
+        use_mmap = true;
+
+    utils::set_mmap(use_mmap.value_or(false));
+
     if (identity == MERGE && fnames.size() < 2)
         print_usage_and_exit = true;
 
@@ -692,6 +706,8 @@ std::string Config::state_to_string(BOSS::State state) {
             return "small";
         case BOSS::State::FAST:
             return "fast";
+        case BOSS::State::FUSED:
+            return "fused";
     }
     throw std::runtime_error("Never happens");
 }
@@ -705,6 +721,8 @@ BOSS::State Config::string_to_state(const std::string &string) {
         return BOSS::State::SMALL;
     } else if (string == "fast") {
         return BOSS::State::FAST;
+    } else if (string == "fused") {
+        return BOSS::State::FUSED;
     } else {
         throw std::runtime_error("Error: unknown graph state");
     }
@@ -970,7 +988,7 @@ if (advanced) {
             fprintf(stderr, "\t   --reference [STR] \tbasename of reference sequence (for parsing VCF files) []\n");
             fprintf(stderr, "\n");
             fprintf(stderr, "\t   --graph [STR] \tgraph representation: succinct / bitmap / hash / hashstr / hashfast [succinct] / sshash\n");
-            fprintf(stderr, "\t   --state [STR] \tstate of succinct graph: small / dynamic / stat / fast [stat]\n");
+            fprintf(stderr, "\t   --state [STR] \tstate of succinct graph: small / dynamic / stat / fast / fused [stat]\n");
             fprintf(stderr, "\t   --inplace \t\tconstruct succinct graph in-place and serialize without loading to RAM [off]\n");
             fprintf(stderr, "\t   --count-kmers \tcount k-mers and build weighted graph [off]\n");
             fprintf(stderr, "\t   --count-width \tnumber of bits used to represent k-mer abundance [8]\n");
@@ -1113,10 +1131,14 @@ if (advanced) {
 
             fprintf(stderr, "Available options for merge:\n");
             fprintf(stderr, "\t-b --bins-per-thread [INT] \tnumber of bins each thread computes on average [1]\n");
+            fprintf(stderr, "\t   --count-kmers \t\tsum up k-mer counts of the input graphs [off]\n");
+            fprintf(stderr, "\t   --count-width \t\tnumber of bits used to represent k-mer abundance [8]\n");
             fprintf(stderr, "\t   --dynamic \t\t\tdynamic merge by adding traversed paths [off]\n");
             fprintf(stderr, "\t   --part-idx [INT] \t\tidx to use when doing external merge []\n");
             fprintf(stderr, "\t   --parts-total [INT] \t\ttotal number of parts in external merge[]\n");
             fprintf(stderr, "\t-p --parallel [INT] \t\tuse multiple threads for computation [1]\n");
+            fprintf(stderr, "\n");
+            fprintf(stderr, "\tUnless --dynamic is set, the input graphs are loaded with memory mapping (--mmap).\n");
         } break;
         case CONCATENATE: {
             fprintf(stderr, "Usage: %s concatenate -o <graph_basename> [options] [[CHUNK] ...]\n\n", prog_name.c_str());
@@ -1138,7 +1160,7 @@ if (advanced) {
             fprintf(stderr, "\t   --index-ranges [INT]\tindex all node ranges in BOSS for suffixes of given length [%zu]\n", kDefaultIndexSuffixLen);
             fprintf(stderr, "\t   --clear-dummy \terase all redundant dummy edges and build an edgemask for non-redundant [off]\n");
             fprintf(stderr, "\t   --prune-tips [INT] \tprune all dead ends of this length and shorter [0]\n");
-            fprintf(stderr, "\t   --state [STR] \tchange state of succinct graph: small / dynamic / stat / fast [stat]\n");
+            fprintf(stderr, "\t   --state [STR] \tchange state of succinct graph: small / dynamic / stat / fast / fused [stat]\n");
             fprintf(stderr, "\t   --to-adj-list \twrite adjacency list to file [off]\n");
             fprintf(stderr, "\t   --to-fasta \t\textract sequences from graph and dump to compressed FASTA file [off]\n");
             fprintf(stderr, "\t   --enumerate \t\tenumerate sequences in FASTA [off]\n");
@@ -1231,6 +1253,8 @@ if (advanced) {
         } break;
         case MERGE_ANNOTATIONS: {
             fprintf(stderr, "Usage: %s merge_anno -o <annotation-basename> [options] ANNOT1 [[ANNOT2] ...]\n\n", prog_name.c_str());
+            fprintf(stderr, "\tMerges annotations with disjoint labels. Row-diff annotations must be\n"
+                            "\ttransformed with the same anchors and fork successors (same graph).\n\n");
 
             fprintf(stderr, "Available options for annotate:\n");
             fprintf(stderr, "\t-p --parallel [INT] \tuse multiple threads for computation [1]\n");
@@ -1270,6 +1294,8 @@ if (advanced) {
             fprintf(stderr, "\t   --row-diff-stage [0|1|2] \tstage of the row_diff construction [0]\n");
             fprintf(stderr, "\t   --max-path-length [INT] \tmaximum path length in row_diff annotation [100]\n");
             fprintf(stderr, "\t   --mem-cap-gb [FLOAT]\tmemory in GB available for the transform [1000]\n");
+            fprintf(stderr, "\t   --mmap \t\tmap the source columns instead of loading them to RAM, which leaves more\n");
+            fprintf(stderr, "\t          \t\tof --mem-cap-gb for the buffers of the transformed columns (for row_diff) [off]\n");
             fprintf(stderr, "\t-i --infile-base [STR] \t\tgraph for generating succ/pred/anchors (for row_diff types) []\n");
             fprintf(stderr, "\t   --count-kmers \t\tadd k-mer counts to the row_diff annotation [off]\n");
             fprintf(stderr, "\t   --coordinates \t\tadd k-mer coordinates to the row_diff annotation [off]\n");
@@ -1284,6 +1310,7 @@ if (advanced) {
 
             fprintf(stderr, "\t-o --outfile-base [STR] basename of output file []\n");
             fprintf(stderr, "\t   --relax-arity [INT] \trelax brwt tree to optimize arity limited to this number [10]\n");
+            fprintf(stderr, "\t   --mem-cap-gb [FLOAT]\tmemory in GB available for the index vectors being rebuilt [1000]\n");
             fprintf(stderr, "\t-p --parallel [INT] \tuse multiple threads for computation [1]\n");
         } break;
         case QUERY: {
@@ -1330,7 +1357,8 @@ if (advanced) {
             // fprintf(stderr, "\t-d --distance [INT] \tmax allowed alignment distance [0]\n");
             fprintf(stderr, "\n");
             fprintf(stderr, "\t-p --parallel [INT] \tuse multiple threads for computation [1]\n");
-            // fprintf(stderr, "\t   --cache-size [INT] \tnumber of uncompressed rows to store in the cache [0]\n");
+            fprintf(stderr, "\t   --cache-size [INT] \tnumber of uncompressed rows to store in the cache (for Rainbow representations only) [0]\n");
+            fprintf(stderr, "\t   --warm-up-cache \tdecode the most frequent rows into the cache when loading [off]\n");
             fprintf(stderr, "\t   --batch-size [INT] \tquery batch size in bp (0 to disable batch query) [100'000'000]\n");
 if (advanced) {
             fprintf(stderr, "\t   --threads-each [INT]\tnumber of parallel batches [1]\n");
@@ -1379,16 +1407,20 @@ if (advanced) {
             fprintf(stderr, "Usage: %s server_query (-i <GRAPH> -a <ANNOTATION> | <GRAPHS.csv>) [options]\n\n"
                             "\tThe index must be passed with flags -i -a or with a file GRAPHS.csv listing one\n"
                             "\tor more indexes, a file with rows: '<name>,<graph_path>,<annotation_path>\\n'.\n"
-                            "\t(If multiple rows have the same name, all those graphs will be queried for that name.)\n\n", prog_name.c_str());
+                            "\t(If multiple rows have the same name, all those graphs will be queried for that name.)\n"
+                            "\tThe indexes are loaded with memory mapping by default, so that multiple servers\n"
+                            "\trunning on the same host share the pages of the same index files.\n\n", prog_name.c_str());
 
             fprintf(stderr, "Available options for server_query:\n");
             fprintf(stderr, "\t   --port [INT] \tTCP port for incoming connections [5555]\n");
             fprintf(stderr, "\t   --address \t\tinterface for incoming connections (default: all)\n");
+            fprintf(stderr, "\t   --no-mmap \t\tload the indexes to RAM instead of memory mapping them [off]\n");
             fprintf(stderr, "\t   --sparse \t\tuse the row-major sparse matrix to annotate graph [off]\n");
             // fprintf(stderr, "\t-o --outfile-base [STR] \tbasename of output file []\n");
             // fprintf(stderr, "\t-d --distance [INT] \tmax allowed alignment distance [0]\n");
             fprintf(stderr, "\t-p --parallel [INT] \tmaximum number of parallel connections [1]\n");
-            // fprintf(stderr, "\t   --cache-size [INT] \tnumber of uncompressed rows to store in the cache [0]\n");
+            fprintf(stderr, "\t   --cache-size [INT] \tnumber of uncompressed rows to store in the cache (for Rainbow representations only) [0]\n");
+            fprintf(stderr, "\t   --warm-up-cache \tdecode the most frequent rows into the cache when loading [off]\n");
             fprintf(stderr, "\n\t   --num-top-labels [INT] \tmaximum number of top labels per query by default [10'000]\n");
         } break;
     }
@@ -58,6 +58,7 @@ class Config {
     bool align_only_forwards = false;
     bool filter_by_kmer = false;
     bool output_json = false;
+    bool warm_up_row_cache = false;
     bool aggregate_columns = false;
     bool coordinates = false;
     bool advanced = false;
@@ -105,6 +106,7 @@ class Config {
     unsigned long long int num_singleton_kmers = 0;
     unsigned long long int max_hull_depth = -1;  // the default is a function of input
     unsigned long long int num_chars = 0;
+    unsigned long long int row_cache_size = 0;
 
     uint8_t count_width = 8;
 
@@ -1,5 +1,7 @@
 #include "load_annotated_graph.hpp"
 
+#include <future>
+
 #include "annotation/binary_matrix/multi_brwt/brwt.hpp"
 #include "annotation/binary_matrix/column_sparse/column_major.hpp"
 #include "annotation/binary_matrix/row_diff/row_diff.hpp"
@@ -8,6 +10,8 @@
 #include "graph/representation/canonical_dbg.hpp"
 #include "graph/annotated_dbg.hpp"
 #include "common/logger.hpp"
+#include "common/unix_tools.hpp"
+#include "common/threads/threading.hpp"
 #include "cli/config/config.hpp"
 #include "load_graph.hpp"
 #include "load_annotation.hpp"
@@ -20,54 +24,81 @@ using namespace mtg::graph;
 using mtg::common::logger;
 
 
-std::unique_ptr<AnnotatedDBG> initialize_annotated_dbg(std::shared_ptr<DeBruijnGraph> graph,
-                                                       const Config &config,
-                                                       size_t max_chunks_open) {
-    uint64_t max_index = graph->max_index();
+typedef AnnotatedDBG::Annotator Annotator;
+
+static std::unique_ptr<Annotator> load_annotation(const Config &config,
+                                                  uint64_t max_index,
+                                                  size_t max_chunks_open) {
+    if (!config.infbase_annotators.size())
+        return initialize_annotation(config.anno_type, config, max_index, max_chunks_open);
+
+    Timer timer;
+    auto annotation = initialize_annotation(config.infbase_annotators.at(0), config,
+                                            0, max_chunks_open);
+    bool loaded = false;
+    if (auto *cc = dynamic_cast<annot::ColumnCompressed<>*>(annotation.get())) {
+        loaded = cc->merge_load(config.infbase_annotators);
+    } else {
+        if (config.infbase_annotators.size() > 1) {
+            logger->warn("Cannot merge annotations of this type. Only the first"
+                         " file {} will be loaded.", config.infbase_annotators.at(0));
+        }
+        loaded = annotation->load(config.infbase_annotators.at(0));
+    }
+    if (!loaded) {
+        logger->error("Cannot load annotations for graph {}, file corrupted",
+                      config.infbase);
+        exit(1);
+    }
+    logger->trace("Annotation loaded in {} sec", timer.elapsed());
 
+    return annotation;
+}
+
+static std::unique_ptr<AnnotatedDBG>
+attach_annotation(std::shared_ptr<DeBruijnGraph> graph,
+                  std::unique_ptr<Annotator>&& annotation,
+                  const Config &config) {
     auto base_graph = graph;
     if (graph->get_mode() == DeBruijnGraph::PRIMARY) {
         graph = std::make_shared<CanonicalDBG>(graph);
         logger->trace("Primary graph wrapped into canonical");
     }
 
-    auto annotation_temp = config.infbase_annotators.size()
-            ? initialize_annotation(config.infbase_annotators.at(0), config, 0, max_chunks_open)
-            : initialize_annotation(config.anno_type, config, max_index, max_chunks_open);
-
     if (config.infbase_annotators.size()) {
-        bool loaded = false;
-        if (auto *cc = dynamic_cast<annot::ColumnCompressed<>*>(annotation_temp.get())) {
-            loaded = cc->merge_load(config.infbase_annotators);
-        } else {
-            if (config.infbase_annotators.size() > 1) {
-                logger->warn("Cannot merge annotations of this type. Only the first"
-                             " file {} will be loaded.", config.infbase_annotators.at(0));
-            }
-            loaded = annotation_temp->load(config.infbase_annotators.at(0));
-        }
-        if (!loaded) {
-            logger->error("Cannot load annotations for graph {}, file corrupted",
-                          config.infbase);
-            exit(1);
-        }
-
         // row_diff annotation is special, as it must know the graph structure
         using namespace annot::matrix;
-        BinaryMatrix &matrix = const_cast<BinaryMatrix &>(annotation_temp->get_matrix());
+        BinaryMatrix &matrix = const_cast<BinaryMatrix &>(annotation->get_matrix());
         if (IRowDiff *row_diff = dynamic_cast<IRowDiff*>(&matrix)) {
             row_diff->set_graph(base_graph.get());
 
             if (auto *row_diff_column = dynamic_cast<RowDiff<ColumnMajor> *>(&matrix)) {
+                Timer timer;
                 row_diff_column->load_anchor(config.infbase + kRowDiffAnchorExt);
                 row_diff_column->load_fork_succ(config.infbase + kRowDiffForkSuccExt);
+                logger->trace("Row-diff anchors and fork successors loaded in {} sec",
+                              timer.elapsed());
             }
         }
     }
 
+    if (config.row_cache_size) {
+        using namespace annot::matrix;
+        BinaryMatrix &matrix = const_cast<BinaryMatrix &>(annotation->get_matrix());
+        if (auto *rainbow = dynamic_cast<RainbowMatrix *>(&matrix)) {
+            Timer timer;
+            rainbow->set_row_cache(config.row_cache_size, config.warm_up_row_cache,
+                                   get_num_threads());
+            if (config.warm_up_row_cache)
+                logger->trace("Row cache warmed up in {} sec", timer.elapsed());
+        } else {
+            logger->warn("The row cache is only supported for Rainbow annotations");
+        }
+    }
+
     // load graph
     auto anno_graph
-            = std::make_unique<AnnotatedDBG>(std::move(graph), std::move(annotation_temp));
+            = std::make_unique<AnnotatedDBG>(std::move(graph), std::move(annotation));
 
     if (!anno_graph->check_compatibility()) {
         logger->error("Graph and annotation are not compatible");
@@ -77,8 +108,33 @@ std::unique_ptr<AnnotatedDBG> initialize_annotated_dbg(std::shared_ptr<DeBruijnG
     return anno_graph;
 }
 
-std::unique_ptr<AnnotatedDBG> initialize_annotated_dbg(const Config &config) {
-    return initialize_annotated_dbg(load_critical_dbg(config.infbase), config);
+std::unique_ptr<AnnotatedDBG> initialize_annotated_dbg(std::shared_ptr<DeBruijnGraph> graph,
+                                                       const Config &config,
+                                                       size_t max_chunks_open) {
+    auto annotation = load_annotation(config, graph->max_index(), max_chunks_open);
+    return attach_annotation(std::move(graph), std::move(annotation), config);
+}
+
+std::unique_ptr<AnnotatedDBG> initialize_annotated_dbg(const Config &config,
+                                                       size_t max_chunks_open) {
+    if (!config.infbase_annotators.size())
+        return initialize_annotated_dbg(load_critical_dbg(config.infbase), config,
+                                        max_chunks_open);
+
+    // Loading the annotation doesn't depend on the graph, so the graph and the
+    // annotation are loaded concurrently, and only then linked together.
+    Timer timer;
+    auto graph_future = std::async(std::launch::async, [&config]() {
+        Timer timer;
+        auto graph = load_critical_dbg(config.infbase);
+        logger->trace("Graph loaded in {} sec", timer.elapsed());
+        return graph;
+    });
+    auto annotation = load_annotation(config, 0, max_chunks_open);
+    auto anno_graph = attach_annotation(graph_future.get(), std::move(annotation), config);
+    logger->trace("Annotated graph loaded in {} sec", timer.elapsed());
+
+    return anno_graph;
 }
 
 
@@ -22,7 +22,9 @@ initialize_annotated_dbg(std::shared_ptr<graph::DeBruijnGraph> graph,
                          const Config &config,
                          size_t max_chunks_open = 2000);
 
-std::unique_ptr<graph::AnnotatedDBG> initialize_annotated_dbg(const Config &config);
+// Load the graph and the annotation concurrently and link them together
+std::unique_ptr<graph::AnnotatedDBG>
+initialize_annotated_dbg(const Config &config, size_t max_chunks_open = 2000);
 
 } // namespace cli
 } // namespace mtg
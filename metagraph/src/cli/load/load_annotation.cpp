@@ -3,6 +3,7 @@
 #include <string>
 
 #include "common/logger.hpp"
+#include "common/utils/file_utils.hpp"
 #include "annotation/representation/row_compressed/annotate_row_compressed.hpp"
 #include "annotation/representation/column_compressed/annotate_column_compressed.hpp"
 #include "annotation/representation/annotation_matrix/static_annotators_def.hpp"
@@ -197,14 +198,14 @@ initialize_annotation(Config::AnnotationType anno_type,
 std::vector<std::string> read_labels(const std::string &anno_fname) {
     annot::LabelEncoder<std::string> label_encoder;
 
-    std::ifstream instream(anno_fname, std::ios::binary);
+    std::unique_ptr<std::ifstream> instream = utils::open_ifstream(anno_fname);
     // TODO: make this cleaner
     if (parse_annotation_type(anno_fname) == Config::ColumnCompressed) {
         // Column compressed dumps the number of rows first
         // skipping it...
-        load_number(instream);
+        load_number(*instream);
     }
-    if (!label_encoder.load(instream))
+    if (!label_encoder.load(*instream))
         throw std::ios_base::failure("Cannot read label encoder from file " + anno_fname);
 
     return label_encoder.get_labels();
@@ -10,6 +10,7 @@
 #include "graph/representation/hash/dbg_sshash.hpp"
 #include "graph/representation/bitmap/dbg_bitmap.hpp"
 #include "graph/representation/succinct/dbg_succinct.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 #include "cli/config/config.hpp"
 
 
@@ -46,33 +47,47 @@ Config::GraphType parse_graph_type(const std::string &filename) {
 }
 
 std::shared_ptr<DeBruijnGraph> load_critical_dbg(const std::string &filename) {
-    auto graph_type = parse_graph_type(filename);
-    switch (graph_type) {
+    std::shared_ptr<DeBruijnGraph> graph;
+
+    switch (parse_graph_type(filename)) {
         case Config::GraphType::SUCCINCT:
+            // DBGSuccinct loads its own Bloom filter
             return load_critical_graph_from_file<DBGSuccinct>(filename);
 
         case Config::GraphType::HASH:
-            return load_critical_graph_from_file<DBGHashOrdered>(filename);
-
+            graph = load_critical_graph_from_file<DBGHashOrdered>(filename);
+            break;
         case Config::GraphType::HASH_PACKED:
-            return load_critical_graph_from_file<DBGHashOrdered>(filename);
-
+            graph = load_critical_graph_from_file<DBGHashOrdered>(filename);
+            break;
         case Config::GraphType::HASH_STR:
-            return load_critical_graph_from_file<DBGHashString>(filename);
-
+            graph = load_critical_graph_from_file<DBGHashString>(filename);
+            break;
         case Config::GraphType::HASH_FAST:
-            return load_critical_graph_from_file<DBGHashFast>(filename);
+            graph = load_critical_graph_from_file<DBGHashFast>(filename);
+            break;
         case Config::GraphType::BITMAP:
-            return load_critical_graph_from_file<graph::DBGBitmap>(filename);
+            graph = load_critical_graph_from_file<graph::DBGBitmap>(filename);
+            break;
         case Config::GraphType::SSHASH:
-            return load_critical_graph_from_file<graph::DBGSSHash>(filename);
+            graph = load_critical_graph_from_file<graph::DBGSSHash>(filename);
+            break;
         case Config::GraphType::INVALID:
             logger->error("Cannot load graph from file '{}', needs a valid file extension",
                           filename);
             exit(1);
     }
-    assert(false);
-    exit(1);
+    assert(graph);
+
+    if (auto bloom_filter = graph->load_extension<NodeBloomFilter>(filename)) {
+        if (!bloom_filter->is_compatible(*graph)) {
+            logger->error("Bloom filter is incompatible with graph '{}'", filename);
+            exit(1);
+        }
+        logger->trace("Loaded Bloom filter for graph '{}'", filename);
+    }
+
+    return graph;
 }
 
 } // namespace cli
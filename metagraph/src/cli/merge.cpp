@@ -3,6 +3,8 @@
 #include "common/logger.hpp"
 #include "common/unix_tools.hpp"
 #include "common/threads/threading.hpp"
+#include "common/utils/file_utils.hpp"
+#include "graph/graph_extensions/node_weights.hpp"
 #include "graph/representation/succinct/boss.hpp"
 #include "graph/representation/succinct/boss_merge.hpp"
 #include "graph/representation/succinct/dbg_succinct.hpp"
@@ -18,6 +20,46 @@ using mtg::common::logger;
 using mtg::common::get_verbose;
 
 
+void merge_weights(graph::DBGSuccinct *merged,
+                   const std::vector<std::string> &files,
+                   uint8_t count_width,
+                   size_t num_threads) {
+    // a plain vector, so that the threads can update distinct counts concurrently
+    std::vector<uint64_t> counts(merged->max_index() + 1, 0);
+    const uint64_t max_count = sdsl::bits::lo_set[count_width];
+
+    for (const auto &file : files) {
+        auto graph = load_critical_graph_from_file<graph::DBGSuccinct>(file);
+        auto weights = graph->load_extension<graph::NodeWeights>(file);
+        if (!weights || !weights->is_compatible(*graph)) {
+            logger->error("Can't load k-mer counts compatible with graph '{}'", file);
+            exit(1);
+        }
+        graph->reset_mask();
+
+        // Every k-mer of the input graph is called exactly once and each k-mer
+        // of the merged graph is matched by a single k-mer of the input graph.
+        graph->call_sequences([&](const std::string &sequence, const auto &path) {
+            size_t i = 0;
+            merged->map_to_nodes_sequentially(sequence, [&](auto node) {
+                assert(node);
+                // saturate without overflowing the 64-bit counters
+                uint64_t weight = (*weights)[path[i++]];
+                counts[node] = weight > max_count - counts[node]
+                                    ? max_count
+                                    : counts[node] + weight;
+            });
+            assert(i == path.size());
+        }, num_threads);
+
+        logger->trace("Merged k-mer counts from '{}'", file);
+    }
+
+    sdsl::int_vector<> merged_weights(counts.size(), 0, count_width);
+    std::copy(counts.begin(), counts.end(), merged_weights.begin());
+    merged->add_extension(std::make_shared<graph::NodeWeights>(std::move(merged_weights)));
+}
+
 int merge_graph(Config *config) {
     assert(config);
 
@@ -25,6 +67,13 @@ int merge_graph(Config *config) {
 
     graph::boss::BOSS *graph = NULL;
 
+    if (!config->dynamic && !utils::with_mmap()) {
+        // The input graphs are only read, so their pages can be loaded on demand
+        // instead of keeping all inputs in RAM at the same time.
+        logger->trace("Input graphs will be loaded with memory mapping");
+        utils::set_mmap(true);
+    }
+
     Timer timer;
 
     std::vector<std::shared_ptr<graph::DBGSuccinct>> dbg_graphs;
@@ -91,6 +140,9 @@ int merge_graph(Config *config) {
         logger->info("Blocks merged in {} sec", timer.elapsed());
 
         if (config->parts_total > 1) {
+            if (config->count_kmers)
+                logger->warn("K-mer counts are not merged when building graph chunks");
+
             chunk.serialize(config->outfbase
                               + "." + std::to_string(config->part_idx)
                               + "_" + std::to_string(config->parts_total));
@@ -110,8 +162,18 @@ int merge_graph(Config *config) {
 
     logger->info("Graphs merged in {} sec", timer.elapsed());
 
+    graph::DBGSuccinct merged(graph, config->graph_mode);
+
+    if (config->count_kmers) {
+        logger->info("Start merging k-mer counts");
+        timer.reset();
+        merge_weights(&merged, files, config->count_width, get_num_threads());
+        logger->info("K-mer counts merged in {} sec", timer.elapsed());
+    }
+
     // graph output
-    graph::DBGSuccinct(graph, config->graph_mode).serialize(config->outfbase);
+    merged.serialize(config->outfbase);
+    merged.serialize_extensions(config->outfbase);
 
     return 0;
 }
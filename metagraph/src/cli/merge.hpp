@@ -1,14 +1,32 @@
 #ifndef __MERGE_GRAPH_HPP__
 #define __MERGE_GRAPH_HPP__
 
+#include <string>
+#include <vector>
+
 
 namespace mtg {
+
+namespace graph {
+class DBGSuccinct;
+} // namespace graph
+
 namespace cli {
 
 class Config;
 
 int merge_graph(Config *config);
 
+/**
+ * Sum up the k-mer counts of the input graphs and attach them to the merged graph.
+ * The input graphs are loaded one by one, and each k-mer count is added to the
+ * count of the same k-mer in the merged graph (saturated at |count_width| bits).
+ */
+void merge_weights(graph::DBGSuccinct *merged,
+                   const std::vector<std::string> &files,
+                   uint8_t count_width,
+                   size_t num_threads);
+
 } // namespace cli
 } // namespace mtg
 
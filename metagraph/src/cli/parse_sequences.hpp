@@ -54,6 +54,83 @@ void parse_sequences_and_log(const std::string &file,
 }
 
 
+// Get the thresholds [min, max) for the counts of k-mers in KMC database,
+// computing them from the count quantiles if those are passed
+inline std::pair<uint64_t, uint64_t>
+get_kmc_count_thresholds(const std::string &file, const Config &config) {
+    uint64_t min_count = config.min_count;
+    uint64_t max_count = config.max_count;
+
+    // compute the quantiles to update the thresholds
+    if (config.min_count_quantile > 0 || config.max_count_quantile < 1) {
+        tsl::hopscotch_map<uint64_t, uint64_t> count_hist;
+        read_kmer_counts(file, [&](uint64_t count) { count_hist[count]++; });
+
+        if (count_hist.size()) {
+            std::vector<std::pair<uint64_t, uint64_t>> count_hist_v(count_hist.begin(),
+                                                                    count_hist.end());
+
+            ips4o::parallel::sort(count_hist_v.begin(), count_hist_v.end(),
+                                  utils::LessFirst(), get_num_threads());
+
+            if (config.min_count_quantile > 0)
+                min_count = utils::get_quantile(count_hist_v, config.min_count_quantile);
+            if (config.max_count_quantile < 1)
+                max_count = utils::get_quantile(count_hist_v, config.max_count_quantile);
+
+            mtg::common::logger->info("Used k-mer count thresholds:\n"
+                                     "min (including): {}\n"
+                                     "max (excluding): {}", min_count, max_count);
+        }
+    }
+
+    return { min_count, max_count };
+}
+
+// Parse k-mers from KMC database and pass them to |call_kmers| in batches
+// packed with two bits per character (see seq_io::read_kmers_packed),
+// without decoding them to strings. The same as parse_sequences otherwise,
+// except that it doesn't support |config.forward_and_reverse|.
+template <class Callback>
+void parse_kmc_kmers_packed(const std::string &file,
+                            const Config &config,
+                            Callback call_kmers) {
+    assert(file_format(file) == "KMC");
+    assert(!config.forward_and_reverse);
+
+    mtg::common::logger->trace("Parsing {}", file);
+
+    if (config.graph_mode == graph::DeBruijnGraph::PRIMARY) {
+        mtg::common::logger->error("Primary graphs can only be constructed from"
+                                   " primary contigs");
+        exit(1);
+    }
+
+    auto [min_count, max_count] = get_kmc_count_thresholds(file, config);
+
+    uint64_t num_kmers = 0;
+    Timer timer;
+
+    read_kmers_packed(
+        file,
+        [&](size_t k, std::vector<uint64_t>&& kmers, std::vector<uint64_t>&& counts) {
+            if (!num_kmers && k != config.k) {
+                mtg::common::logger->warn("k-mers parsed from KMC database {} have "
+                                         "length {} but graph is constructed for k={}",
+                                         file, k, config.k);
+            }
+            num_kmers += counts.size();
+            call_kmers(k, std::move(kmers), std::move(counts));
+        },
+        // For canonical graph the rev-compl k-mers will be called automatically anyway
+        config.graph_mode != graph::DeBruijnGraph::CANONICAL,
+        min_count, max_count
+    );
+
+    mtg::common::logger->trace("Extracted all {} k-mers from file {} in {} sec",
+                               num_kmers, file, timer.elapsed());
+}
+
 template <class Callback>
 void parse_sequences(const std::string &file,
                      const Config &config,
@@ -76,31 +153,7 @@ void parse_sequences(const std::string &file,
     } else if (file_format(file) == "KMC") {
         bool warning_different_k = false;
 
-        auto min_count = config.min_count;
-        auto max_count = config.max_count;
-
-        // compute the quantiles to update the thresholds
-        if (config.min_count_quantile > 0 || config.max_count_quantile < 1) {
-            tsl::hopscotch_map<uint64_t, uint64_t> count_hist;
-            read_kmers(file, [&](auto, uint32_t count) { count_hist[count]++; }, false);
-
-            if (count_hist.size()) {
-                std::vector<std::pair<uint64_t, uint64_t>> count_hist_v(count_hist.begin(),
-                                                                        count_hist.end());
-
-                ips4o::parallel::sort(count_hist_v.begin(), count_hist_v.end(),
-                                      utils::LessFirst(), get_num_threads());
-
-                if (config.min_count_quantile > 0)
-                    min_count = utils::get_quantile(count_hist_v, config.min_count_quantile);
-                if (config.max_count_quantile < 1)
-                    max_count = utils::get_quantile(count_hist_v, config.max_count_quantile);
-
-                mtg::common::logger->info("Used k-mer count thresholds:\n"
-                                         "min (including): {}\n"
-                                         "max (excluding): {}", min_count, max_count);
-            }
-        }
+        auto [min_count, max_count] = get_kmc_count_thresholds(file, config);
 
         read_kmers(
             file,
@@ -13,6 +13,8 @@
 #include "common/vectors/vector_algorithm.hpp"
 #include "annotation/representation/annotation_matrix/static_annotators_def.hpp"
 #include "graph/alignment/dbg_aligner.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
+#include "graph/representation/base/dbg_wrapper.hpp"
 #include "graph/representation/hash/dbg_hash_ordered.hpp"
 #include "graph/representation/succinct/dbg_succinct.hpp"
 #include "graph/representation/succinct/boss_construct.hpp"
@@ -27,6 +29,8 @@ namespace mtg {
 namespace cli {
 
 const bool kPrefilterWithBloom = true;
+// total length of the query sequences indexed in parallel at once
+const size_t kBatchGraphBufferSize = 10'000'000;
 const char ALIGNED_SEQ_HEADER_FORMAT[] = "{}:{}:{}:{}";
 
 using namespace mtg::graph;
@@ -163,9 +167,40 @@ Json::Value get_label_as_json(const std::string &label) {
     return label_root;
 }
 
+LabelJsonIndex::LabelJsonIndex(const annot::LabelEncoder<std::string> &label_encoder,
+                               size_t num_threads)
+      : label_encoder_(label_encoder), labels_json_(label_encoder.size()) {
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024)
+    for (size_t i = 0; i < labels_json_.size(); ++i) {
+        try {
+            labels_json_[i] = get_label_as_json(label_encoder.decode(i));
+        } catch (...) {
+            // the error will be reported when the label is queried
+        }
+    }
+}
+
+const Json::Value* LabelJsonIndex::find(const std::string &label) const {
+    size_t code = label_encoder_.find(label);
+    if (code == label_encoder_.npos || labels_json_[code].isNull())
+        return nullptr;
+
+    return &labels_json_[code];
+}
+
+Json::Value& LabelJsonIndex::append_to(Json::Value *array, const std::string &label) const {
+    assert(array);
+
+    if (const Json::Value *label_json = find(label))
+        return array->append(*label_json);
+
+    return array->append(get_label_as_json(label));
+}
+
 
 Json::Value SeqSearchResult::to_json(bool verbose_output,
-                                     const graph::AnnotatedDBG &anno_graph) const {
+                                     const graph::AnnotatedDBG &anno_graph,
+                                     const LabelJsonIndex *label_json) const {
     Json::Value root;
 
     // Add seq information
@@ -184,24 +219,30 @@ Json::Value SeqSearchResult::to_json(bool verbose_output,
     }
 
     // Add discovered labels and extra results
-    root["results"] = Json::Value(Json::arrayValue);
+    Json::Value &results = (root["results"] = Json::Value(Json::arrayValue));
+
+    // the indexed JSON of each label is copied only once, into the results
+    auto append_label = [&results,label_json](const std::string &label) -> Json::Value& {
+        return label_json ? label_json->append_to(&results, label)
+                          : results.append(get_label_as_json(label));
+    };
 
     // Different action depending on the result type
     if (const auto *v = std::get_if<LabelVec>(&result_)) {
         // Standard labels only
         for (const auto &label : *v) {
-            root["results"].append(get_label_as_json(label));
+            append_label(label);
         }
     } else if (const auto *v = std::get_if<LabelCountVec>(&result_)) {
         // Labels with count data
         for (const auto &[label, count] : *v) {
-            Json::Value &label_obj = root["results"].append(get_label_as_json(label));
+            Json::Value &label_obj = append_label(label);
             label_obj[KMER_COUNT_FIELD] = static_cast<Json::Int64>(count);
         }
     } else if (const auto *v = std::get_if<LabelSigVec>(&result_)) {
         // Count signatures
         for (const auto &[label, kmer_presence_mask] : *v) {
-            Json::Value &label_obj = root["results"].append(get_label_as_json(label));
+            Json::Value &label_obj = append_label(label);
             // Store the presence mask and score in a separate object
             Json::Value &sig_obj = (label_obj[SIGNATURE_FIELD] = Json::objectValue);
             sig_obj["presence_mask"] = Json::Value(sdsl::util::to_string(kmer_presence_mask));
@@ -213,7 +254,7 @@ Json::Value SeqSearchResult::to_json(bool verbose_output,
         // k-mer counts (or quantiles)
         for (const auto &[label, count, abundances] : *v) {
             assert(abundances.size());
-            Json::Value &label_obj = root["results"].append(get_label_as_json(label));
+            Json::Value &label_obj = append_label(label);
             label_obj[KMER_COUNT_FIELD] = static_cast<Json::Int64>(count);
             Json::Value &counts_array = (label_obj[KMER_ABUNDANCE_FIELD] = Json::arrayValue);
             if (verbose_output) {
@@ -246,7 +287,7 @@ Json::Value SeqSearchResult::to_json(bool verbose_output,
     } else {
         // Kmer coordinates
         for (const auto &[label, count, tuples] : std::get<LabelCountCoordsVec>(result_)) {
-            Json::Value &label_obj = root["results"].append(get_label_as_json(label));
+            Json::Value &label_obj = append_label(label);
             label_obj[KMER_COUNT_FIELD] = static_cast<Json::Int64>(count);
             Json::Value &coord_array = (label_obj[KMER_COORDINATE_FIELD] = Json::arrayValue);
 
@@ -903,29 +944,50 @@ construct_query_graph(const AnnotatedDBG &anno_graph,
 
     logger->trace("[Query graph construction] Building the batch graph...");
 
-    if (kPrefilterWithBloom && dbg_succ && sub_k == full_dbg.get_k()) {
-        if (dbg_succ->get_bloom_filter())
-            logger->trace(
-                    "[Query graph construction] Started indexing k-mers pre-filtered "
-                    "with Bloom filter");
-
-        call_sequences([&](const std::string &sequence) {
-            // TODO: implement add_sequence with filter for all graph representations
-            graph_init->add_sequence(
-                sequence,
-                get_missing_kmer_skipper(dbg_succ->get_bloom_filter(), sequence)
-            );
-            if (max_input_sequence_length < sequence.length())
-                max_input_sequence_length = sequence.length();
-        });
-    } else {
-        call_sequences([&](const std::string &sequence) {
-            graph_init->add_sequence(sequence);
-            if (max_input_sequence_length < sequence.length())
-                max_input_sequence_length = sequence.length();
-        });
+    // use the Bloom filter of DBGSuccinct or the one loaded as a graph extension
+    const kmer::KmerBloomFilter<> *bloom_filter = dbg_succ ? dbg_succ->get_bloom_filter() : NULL;
+    if (!bloom_filter) {
+        const DeBruijnGraph *base_graph = &full_dbg;
+        if (const auto *wrapper = dynamic_cast<const graph::DBGWrapper<>*>(base_graph))
+            base_graph = &wrapper->get_graph();
+
+        if (const auto *extension = base_graph->get_extension_threadsafe<graph::NodeBloomFilter>())
+            bloom_filter = &extension->get_filter();
     }
 
+    DBGHashOrdered::SkipperGenerator get_skipper = [](std::string_view) {
+        return []() { return false; };
+    };
+    if (kPrefilterWithBloom && bloom_filter && sub_k == full_dbg.get_k()) {
+        logger->trace("[Query graph construction] Started indexing k-mers pre-filtered "
+                      "with Bloom filter");
+        get_skipper = [bloom_filter](std::string_view sequence) {
+            return get_missing_kmer_skipper(bloom_filter, sequence);
+        };
+    }
+
+    // The sequences are buffered and their k-mers are extracted in parallel.
+    // The k-mers of each buffer are inserted in sorted order, so the batch
+    // graph and the contigs extracted from it don't depend on |num_threads|.
+    std::vector<std::string> buffer;
+    size_t buffer_length = 0;
+    auto flush_buffer = [&]() {
+        graph_init->add_sequences(buffer, get_skipper, num_threads);
+        buffer.clear();
+        buffer_length = 0;
+    };
+
+    call_sequences([&](const std::string &sequence) {
+        buffer.push_back(sequence);
+        buffer_length += sequence.length();
+        if (buffer_length >= kBatchGraphBufferSize)
+            flush_buffer();
+
+        if (max_input_sequence_length < sequence.length())
+            max_input_sequence_length = sequence.length();
+    });
+    flush_buffer();
+
     max_hull_depth = std::min(
         max_hull_depth,
         static_cast<size_t>(max_hull_depth_per_seq_char * max_input_sequence_length)
@@ -24,6 +24,11 @@ namespace seq_io {
     class FastaParser;
 }
 
+namespace annot {
+    template <typename Label>
+    class LabelEncoder;
+}
+
 namespace graph {
     class AnnotatedDBG;
     namespace align {
@@ -82,6 +87,32 @@ struct Alignment {
 };
 
 
+/**
+ * The JSON representations of all labels of an annotation with their properties,
+ * built once, e.g., when the server loads the index, so that the labels are not
+ * parsed again for every response.
+ */
+class LabelJsonIndex {
+  public:
+    // |label_encoder| must outlive the index
+    LabelJsonIndex(const annot::LabelEncoder<std::string> &label_encoder,
+                   size_t num_threads = 1);
+
+    // Return the indexed JSON representation of |label|, or nullptr if the
+    // label is missing in the index or failed to parse
+    const Json::Value* find(const std::string &label) const;
+
+    // Append the JSON representation of |label| to |array| and return it.
+    // The labels missing in the index are parsed on the fly.
+    Json::Value& append_to(Json::Value *array, const std::string &label) const;
+
+  private:
+    const annot::LabelEncoder<std::string> &label_encoder_;
+    // indexed by label codes, null for the labels that failed to parse
+    std::vector<Json::Value> labels_json_;
+};
+
+
 /**
  * Search result for an individual sequence. Stores the search result in one of several possible
  * vector types (kmer counts, label counts, quantiles, coordinates, signatures) represented
@@ -146,9 +177,12 @@ class SeqSearchResult {
      * @param counts_kmers      should counts be labeled kmer (t) or label (f) counts?
      * @param anno_graph        reference to annotated dbg for kmer presence mask scoring
      * @param verbose_output    do not collapse continuous ranges of coords (or counts)
+     * @param label_json        pre-parsed labels of the annotation, if available
      * @return  Json::Value instance representing sequence result
      */
-    Json::Value to_json(bool verbose_output, const graph::AnnotatedDBG &anno_graph) const;
+    Json::Value to_json(bool verbose_output,
+                        const graph::AnnotatedDBG &anno_graph,
+                        const LabelJsonIndex *label_json = nullptr) const;
 
     /**
      * Returns a string representing the individual query result for the represented sequence.
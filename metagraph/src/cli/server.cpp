@@ -9,6 +9,7 @@
 #include "common/utils/template_utils.hpp"
 #include "graph/alignment/dbg_aligner.hpp"
 #include "graph/annotated_dbg.hpp"
+#include "graph/representation/canonical_dbg.hpp"
 #include "annotation/int_matrix/base/int_matrix.hpp"
 #include "seq_io/sequence_io.hpp"
 #include "config/config.hpp"
@@ -31,7 +32,8 @@ using HttpServer = SimpleWeb::Server<SimpleWeb::HTTP>;
 
 Json::Value process_search_request(const Json::Value &json,
                                    const graph::AnnotatedDBG &anno_graph,
-                                   const Config &config_orig) {
+                                   const Config &config_orig,
+                                   const LabelJsonIndex *label_json = nullptr) {
     const auto &fasta = json["FASTA"];
     if (fasta.isNull())
         throw std::domain_error("No input sequences received from client");
@@ -129,7 +131,7 @@ Json::Value process_search_request(const Json::Value &json,
     // Create full JSON object
     Json::Value search_response(Json::arrayValue);
     for (const auto &seq_result : search_results) {
-        search_response.append(seq_result.to_json(config.verbose_output, anno_graph));
+        search_response.append(seq_result.to_json(config.verbose_output, anno_graph, label_json));
     }
 
     return search_response;
@@ -269,21 +271,38 @@ std::vector<std::string> filter_graphs_from_list(
 int run_server(Config *config) {
     assert(config);
     std::atomic<size_t> num_requests = 0;
+    // pages read from disk by the whole process since the index was loaded,
+    // mostly by queries to the memory-mapped indexes
+    std::atomic<uint64_t> page_ins_baseline = get_num_page_ins();
+    std::atomic<size_t> num_search_requests = 0;
 
     ThreadPool graph_loader(1, 1);
     std::shared_future<std::unique_ptr<AnnotatedDBG>> anno_graph;
+    // set by the loader before |anno_graph| becomes ready
+    std::unique_ptr<LabelJsonIndex> label_json;
 
     tsl::hopscotch_map<std::string, std::vector<std::pair<std::string, std::string>>> indexes;
 
     if (config->infbase_annotators.size() == 1) {
         assert(config->fnames.empty());
         anno_graph = graph_loader.enqueue([&]() {
-            logger->info("[Server] Loading graph...");
-            auto graph = load_critical_dbg(config->infbase);
-            logger->info("[Server] Graph loaded. Current mem usage: {} MiB", get_curr_RSS() >> 20);
-
-            auto anno_graph = initialize_annotated_dbg(graph, *config);
-            logger->info("[Server] Annotated graph loaded too. Current mem usage: {} MiB", get_curr_RSS() >> 20);
+            logger->info("[Server] Loading graph and annotation...");
+            Timer timer;
+            auto anno_graph = initialize_annotated_dbg(*config);
+            logger->info("[Server] Annotated graph loaded in {} sec. Current mem usage: {} MiB",
+                         timer.elapsed(), get_curr_RSS() >> 20);
+
+            // parse all labels once instead of for every response
+            timer.reset();
+            const size_t rss_before = get_curr_RSS();
+            label_json = std::make_unique<LabelJsonIndex>(
+                    anno_graph->get_annotator().get_label_encoder(), get_num_threads());
+            const size_t rss_after = get_curr_RSS();
+            logger->info("[Server] Indexed {} labels in {} sec, taking approx. {} MiB",
+                         anno_graph->get_annotator().num_labels(), timer.elapsed(),
+                         (rss_after - std::min(rss_before, rss_after)) >> 20);
+            // don't count the pages read while loading
+            page_ins_baseline = get_num_page_ins();
             return anno_graph;
         });
     } else {
@@ -325,11 +344,6 @@ int run_server(Config *config) {
         }
         logger->info("[Server] Loaded paths for {} graphs for {} names: {}",
                      num_indexes, indexes.size(), fmt::join(names, ", "));
-        if (!utils::with_mmap()) {
-            logger->warn("[Server] --mmap wasn't passed but all indexes will be loaded with mmap."
-                         " Make sure they're on a fast disk.");
-            utils::with_mmap(true);
-        }
     }
 
     ThreadPool graphs_pool(get_num_threads());
@@ -361,12 +375,16 @@ int run_server(Config *config) {
             Json::Value content_json = parse_json_string(content);
             logger->info("Request {}: {}", request_id, content_json.toStyledString());
             Json::Value result;
+            // counted for the whole process, so this includes the pages read
+            // by all requests served concurrently with this one
+            uint64_t page_ins = get_num_page_ins();
 
             // simple case with a single graph pair
             if (!config->fnames.size()) {
                 if (content_json.isMember("graphs"))
                     throw std::invalid_argument("Bad request: no support for filtering graphs on this server");
-                result = process_search_request(content_json, *anno_graph.get(), *config);
+                result = process_search_request(content_json, *anno_graph.get(), *config,
+                                                label_json.get());
             } else {
                 std::vector<std::string> graphs_to_query
                         = filter_graphs_from_list(indexes, content_json, request_id);
@@ -402,7 +420,9 @@ int run_server(Config *config) {
                     future.wait();
                 }
             }
-            logger->info("Request {} finished", request_id);
+            num_search_requests++;
+            logger->info("Request {} finished, {} pages read from disk by the process meanwhile",
+                         request_id, get_num_page_ins() - page_ins);
             return result;
         });
     };
@@ -476,12 +496,28 @@ int run_server(Config *config) {
                 root["graph"]["nodes"] = anno_graph.get()->get_graph().num_nodes();
                 root["graph"]["is_canonical_mode"] = (anno_graph.get()->get_graph().get_mode()
                                                         == graph::DeBruijnGraph::CANONICAL);
+                if (const auto *canonical = dynamic_cast<const graph::CanonicalDBG *>(
+                                                    &anno_graph.get()->get_graph())) {
+                    root["graph"]["cache"]["hits"] = canonical->num_cache_hits();
+                    root["graph"]["cache"]["misses"] = canonical->num_cache_misses();
+                }
                 const auto &annotation = anno_graph.get()->get_annotator();
                 root["annotation"]["filename"] = std::filesystem::path(config->infbase_annotators.front()).filename().string();
                 root["annotation"]["labels"] = static_cast<uint64_t>(annotation.num_labels());
                 root["annotation"]["objects"] = static_cast<uint64_t>(annotation.num_objects());
                 root["annotation"]["relations"] = static_cast<uint64_t>(annotation.num_relations());
+                if (const auto *rainbow = dynamic_cast<const annot::matrix::RainbowMatrix *>(
+                                                    &annotation.get_matrix())) {
+                    root["annotation"]["cache"]["hits"] = rainbow->num_cache_hits();
+                    root["annotation"]["cache"]["misses"] = rainbow->num_cache_misses();
+                }
             }
+            // the page-ins are counted for the whole process, not per query
+            uint64_t page_ins = get_num_page_ins() - page_ins_baseline;
+            root["queries"]["search"] = static_cast<uint64_t>(num_search_requests);
+            root["process"]["page_ins_since_load"] = page_ins;
+            root["process"]["page_ins_per_search_query"]
+                = num_search_requests ? static_cast<double>(page_ins) / num_search_requests : 0.;
             return root;
         });
     };
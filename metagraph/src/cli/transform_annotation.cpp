@@ -5,6 +5,7 @@
 #include "common/logger.hpp"
 #include "common/unix_tools.hpp"
 #include "common/threads/threading.hpp"
+#include "common/utils/file_utils.hpp"
 #include "annotation/representation/row_compressed/annotate_row_compressed.hpp"
 #include "annotation/representation/column_compressed/annotate_column_compressed.hpp"
 #include "annotation/representation/annotation_matrix/static_annotators_def.hpp"
@@ -750,6 +751,9 @@ int transform_annotation(Config *config) {
                 return 0;
             }
             case Config::RowDiff: {
+                if (utils::with_mmap())
+                    logger->info("The source columns will be loaded with memory mapping");
+
                 auto out_dir = std::filesystem::path(config->outfbase).remove_filename();
                 convert_to_row_diff(files, config->infbase, config->memory_available * 1e9,
                                     config->max_path_length, out_dir, config->tmp_dir,
@@ -938,6 +942,12 @@ int merge_annotation(Config *config) {
         merge_row_compressed(files, config->outfbase);
     } else if (anno_type == Config::BRWT) {
         merge_brwt(files, config->outfbase);
+    } else if (anno_type == Config::RowDiff) {
+        merge_row_diff<RowDiffColumnAnnotator>(files, config->outfbase, get_num_threads());
+    } else if (anno_type == Config::RowDiffBRWT) {
+        merge_row_diff<RowDiffBRWTAnnotator>(files, config->outfbase, get_num_threads());
+    } else if (anno_type == Config::RowDiffDisk) {
+        merge_row_diff<RowDiffDiskAnnotator>(files, config->outfbase, get_num_threads());
     } else {
         logger->error("Merging of annotations to '{}' representation is not implemented",
                       config->annotype_to_string(anno_type));
@@ -1016,7 +1026,8 @@ int relax_multi_brwt(Config *config) {
 
     logger->trace("Relaxing BRWT tree...");
     relax_BRWT(&dynamic_cast<matrix::BRWT &>(const_cast<matrix::BinaryMatrix &>(*mat)),
-               config->relax_arity_brwt, get_num_threads());
+               config->relax_arity_brwt, get_num_threads(),
+               config->memory_available * 1e9);
 
     annotator->serialize(config->outfbase);
     logger->trace("BRWT relaxation done in {} sec", timer.elapsed());
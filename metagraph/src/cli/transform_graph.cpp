@@ -7,6 +7,7 @@
 #include "common/utils/file_utils.hpp"
 #include "common/threads/threading.hpp"
 #include "graph/representation/succinct/dbg_succinct.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 #include "config/config.hpp"
 #include "load/load_graph.hpp"
 
@@ -37,6 +38,24 @@ int transform_graph(Config *config) {
 
     auto dbg_succ = std::dynamic_pointer_cast<graph::DBGSuccinct>(graph);
 
+    if (!dbg_succ.get() && config->initialize_bloom) {
+        logger->trace("Construct Bloom filter for nodes...");
+        timer.reset();
+
+        graph::NodeBloomFilter bloom_filter(*graph,
+                                            config->bloom_bpk,
+                                            config->bloom_fpp,
+                                            config->bloom_max_num_hash_functions,
+                                            get_num_threads());
+
+        logger->trace("Bloom filter constructed in {} sec", timer.elapsed());
+
+        // the filter is stored next to the graph, in <outfbase>.bloom
+        graph->serialize(config->outfbase);
+        bloom_filter.serialize(utils::make_suffix(config->outfbase, graph->file_extension()));
+        return 0;
+    }
+
     if (!dbg_succ.get()) {
         logger->warn("Transformations only implemented for DBGSuccinct, serializing graph and exiting");
         graph->serialize(config->outfbase);
@@ -0,0 +1,310 @@
+#include "block_table.hpp"
+
+#include <cassert>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+
+#include <zlib.h>
+
+#include "common/logger.hpp"
+#include "common/serialization.hpp"
+#include "common/threads/threading.hpp"
+
+
+namespace mtg {
+namespace common {
+
+const uint64_t kMagic = 0x454c'4241'544b'4c42; // "BLKTABLE"
+// the fixed part of the table: block size, data size, n, m, and the magic
+const uint64_t kFooterSize = 5 * 8;
+
+static uint32_t compute_checksum(const std::vector<char> &block) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(block.data()), block.size());
+    return crc;
+}
+
+// Read |size| bytes at |offset| from |filename|. Return the bytes read or an
+// empty vector on failure.
+static std::vector<char> read_block(const std::string &filename,
+                                    uint64_t offset, uint64_t size) {
+    std::vector<char> block(size);
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.seekg(offset) || !in.read(block.data(), size))
+        return {};
+
+    return block;
+}
+
+BlockTableWriter::BlockTableWriter(std::ostream &out, uint64_t block_size)
+      : out_(out), dest_(out.rdbuf()), buf_(dest_, block_size) {
+    assert(block_size && block_size <= std::numeric_limits<uInt>::max());
+    assert(out.tellp() == 0);
+    out_.rdbuf(&buf_);
+}
+
+BlockTableWriter::~BlockTableWriter() {
+    if (!finished_)
+        out_.rdbuf(dest_);
+}
+
+void BlockTableWriter::append_table(const std::vector<uint64_t> &sections) {
+    assert(!finished_);
+
+    out_.flush();
+    const uint64_t data_size = buf_.size();
+    const std::vector<uint32_t> checksums = buf_.finish();
+    out_.rdbuf(dest_);
+    finished_ = true;
+
+    for (uint32_t checksum : checksums) {
+        serialize_number(out_, checksum);
+    }
+    for (uint64_t offset : sections) {
+        assert(offset <= data_size);
+        serialize_number(out_, offset);
+    }
+    serialize_number(out_, buf_.block_size());
+    serialize_number(out_, data_size);
+    serialize_number(out_, checksums.size());
+    serialize_number(out_, sections.size());
+    serialize_number(out_, kMagic);
+}
+
+BlockTableWriter::ChecksumStreambuf::ChecksumStreambuf(std::streambuf *dest,
+                                                       uint64_t block_size)
+      : dest_(dest),
+        block_size_(block_size),
+        checksum_(crc32(0L, Z_NULL, 0)) {}
+
+std::vector<uint32_t> BlockTableWriter::ChecksumStreambuf::finish() {
+    if (size_ % block_size_)
+        checksums_.push_back(checksum_);
+
+    return std::move(checksums_);
+}
+
+std::streamsize BlockTableWriter::ChecksumStreambuf::xsputn(const char *s,
+                                                          std::streamsize n) {
+    const std::streamsize written = dest_->sputn(s, n);
+
+    for (std::streamsize i = 0; i < written; ) {
+        // the bytes left in the current block
+        const uint64_t size = std::min(static_cast<uint64_t>(written - i),
+                                       block_size_ - size_ % block_size_);
+        checksum_ = crc32(checksum_, reinterpret_cast<const Bytef *>(s + i), size);
+        size_ += size;
+        i += size;
+        if (size_ % block_size_ == 0) {
+            checksums_.push_back(checksum_);
+            checksum_ = crc32(0L, Z_NULL, 0);
+        }
+    }
+
+    return written;
+}
+
+BlockTableWriter::ChecksumStreambuf::int_type
+BlockTableWriter::ChecksumStreambuf::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    const char ch = traits_type::to_char_type(c);
+    return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+}
+
+int BlockTableWriter::ChecksumStreambuf::sync() {
+    return dest_->pubsync();
+}
+
+BlockTableWriter::ChecksumStreambuf::pos_type
+BlockTableWriter::ChecksumStreambuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                             std::ios_base::openmode which) {
+    // only report the current position, the data can't be overwritten
+    if (off || dir != std::ios_base::cur || !(which & std::ios_base::out))
+        return pos_type(off_type(-1));
+
+    return pos_type(size_);
+}
+
+bool BlockTable::load(const std::string &filename) {
+    *this = BlockTable();
+
+    try {
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        const uint64_t file_size = in.tellg();
+        if (!in.good() || file_size < kFooterSize)
+            return false;
+
+        in.seekg(file_size - kFooterSize);
+        const uint64_t block_size = load_number(in);
+        const uint64_t data_size = load_number(in);
+        const uint64_t num_blocks = load_number(in);
+        const uint64_t num_sections = load_number(in);
+
+        if (load_number(in) != kMagic
+                || !block_size
+                || data_size > file_size - kFooterSize
+                || num_blocks != (data_size + block_size - 1) / block_size
+                || num_sections > file_size / 8
+                || data_size + (num_blocks + num_sections) * 8 + kFooterSize != file_size)
+            return false;
+
+        in.seekg(data_size);
+        std::vector<uint32_t> checksums(num_blocks);
+        for (uint32_t &checksum : checksums) {
+            checksum = load_number(in);
+        }
+        std::vector<uint64_t> sections(num_sections);
+        for (uint64_t &offset : sections) {
+            offset = load_number(in);
+            if (offset > data_size)
+                return false;
+        }
+
+        if (!in.good())
+            return false;
+
+        block_size_ = block_size;
+        data_size_ = data_size;
+        checksums_ = std::move(checksums);
+        sections_ = std::move(sections);
+        return true;
+
+    } catch (...) {
+        return false;
+    }
+}
+
+
+BlockIfstream::BlockIfstream(const std::string &filename,
+                             const BlockTable &table,
+                             uint64_t begin,
+                             uint64_t end,
+                             ThreadPool &thread_pool,
+                             size_t read_ahead)
+      : std::istream(nullptr),
+        buf_(filename, table, begin, end, thread_pool, read_ahead) {
+    rdbuf(&buf_);
+}
+
+BlockIfstream::BlockStreambuf::BlockStreambuf(const std::string &filename,
+                                              const BlockTable &table,
+                                              uint64_t begin,
+                                              uint64_t end,
+                                              ThreadPool &thread_pool,
+                                              size_t read_ahead)
+      : filename_(filename),
+        table_(table),
+        begin_(begin),
+        end_(end),
+        thread_pool_(thread_pool),
+        read_ahead_(std::max(read_ahead, (size_t)1)) {
+    assert(begin_ <= end_);
+    assert(end_ <= table_.data_size());
+    seek(begin_);
+}
+
+void BlockIfstream::BlockStreambuf::seek(uint64_t pos) {
+    pending_.clear();
+    block_.reset();
+    setg(nullptr, nullptr, nullptr);
+    pos_ = pos;
+    front_offset_ = next_offset_ = pos - pos % table_.block_size();
+}
+
+void BlockIfstream::BlockStreambuf::schedule_next_block() {
+    const uint64_t block_size = table_.block_size();
+    const uint64_t size = std::min(block_size, table_.data_size() - next_offset_);
+    const uint32_t checksum = table_.checksum(next_offset_ / block_size);
+
+    pending_.push_back(thread_pool_.enqueue(
+        [](const std::string &filename, uint64_t offset, uint64_t size, uint32_t checksum) {
+            auto block = std::make_shared<std::vector<char>>(read_block(filename, offset, size));
+            return block->size() == size && compute_checksum(*block) == checksum
+                    ? block : nullptr;
+        },
+        filename_, next_offset_, size, checksum
+    ));
+    next_offset_ += block_size;
+}
+
+BlockIfstream::BlockStreambuf::int_type BlockIfstream::BlockStreambuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    if (pos_ >= end_)
+        return traits_type::eof();
+
+    while (pending_.size() < read_ahead_ && next_offset_ < end_) {
+        schedule_next_block();
+    }
+    assert(pending_.size());
+    assert(front_offset_ <= pos_);
+
+    const uint64_t offset = front_offset_;
+    block_ = pending_.front().get();
+    pending_.pop_front();
+    front_offset_ += table_.block_size();
+
+    if (!block_) {
+        logger->error("Failed to read or verify the block at offset {} of file {}",
+                      offset, filename_);
+        seek(end_);
+        return traits_type::eof();
+    }
+
+    const uint64_t size = std::min(offset + block_->size(), end_) - offset;
+    setg(block_->data(), block_->data() + (pos_ - offset), block_->data() + size);
+    pos_ = offset + size;
+
+    return traits_type::to_int_type(*gptr());
+}
+
+BlockIfstream::BlockStreambuf::pos_type
+BlockIfstream::BlockStreambuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                       std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    // the position of gptr() in the file
+    const uint64_t cur = pos_ - (egptr() - gptr());
+
+    uint64_t target;
+    switch (dir) {
+        case std::ios_base::beg:
+            target = off;
+            break;
+        case std::ios_base::cur:
+            if (!off)
+                return pos_type(cur);
+            target = cur + off;
+            break;
+        case std::ios_base::end:
+            target = end_ + off;
+            break;
+        default:
+            return pos_type(off_type(-1));
+    }
+
+    if (target < begin_ || target > end_)
+        return pos_type(off_type(-1));
+
+    if (target <= pos_ && target >= pos_ - (egptr() - eback())) {
+        // the target is in the current block
+        setg(eback(), egptr() - (pos_ - target), egptr());
+    } else {
+        seek(target);
+    }
+
+    return pos_type(target);
+}
+
+BlockIfstream::BlockStreambuf::pos_type
+BlockIfstream::BlockStreambuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+} // namespace common
+} // namespace mtg
@@ -0,0 +1,163 @@
+#ifndef __BLOCK_TABLE_HPP__
+#define __BLOCK_TABLE_HPP__
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+
+namespace mtg {
+namespace common {
+
+/**
+ * A table of contents of a binary file, which splits it into fixed-size blocks
+ * and stores a checksum (CRC-32) for each of them, and the offsets of the
+ * sections of the file which can be read independently.
+ *
+ * The table is appended to the end of the file:
+ *   [checksum_1]...[checksum_n][section_1]...[section_m]
+ *   [block_size][data_size][n][m][kMagic]
+ * The readers of the data stop before the table, so the files with and without
+ * it have the same layout.
+ */
+class BlockTable {
+  public:
+    static constexpr uint64_t kDefaultBlockSize = 1 << 23;
+
+    // Return false if |filename| doesn't end with a valid table
+    bool load(const std::string &filename);
+
+    uint64_t data_size() const { return data_size_; }
+    uint64_t block_size() const { return block_size_; }
+    uint64_t num_blocks() const { return checksums_.size(); }
+    uint32_t checksum(uint64_t block) const { return checksums_[block]; }
+    const std::vector<uint64_t>& sections() const { return sections_; }
+
+  private:
+    uint64_t block_size_ = 0;
+    uint64_t data_size_ = 0;
+    std::vector<uint32_t> checksums_;
+    std::vector<uint64_t> sections_;
+};
+
+
+/**
+ * Computes the checksums of the blocks of the data written to |out| on the
+ * fly, and appends the BlockTable to |out| once all the data is written.
+ * The writer replaces the buffer of |out| until the table is appended or the
+ * writer is destroyed. The stream reports the number of bytes written so far
+ * in tellp(), which can be used as the offset of a section.
+ */
+class BlockTableWriter {
+  public:
+    // |out| must be at the beginning of the file
+    explicit BlockTableWriter(std::ostream &out,
+                              uint64_t block_size = BlockTable::kDefaultBlockSize);
+    // Restore the buffer of |out| without appending the table
+    ~BlockTableWriter();
+
+    // Append the table with |sections| to |out| and restore its buffer
+    void append_table(const std::vector<uint64_t> &sections);
+
+  private:
+    class ChecksumStreambuf : public std::streambuf {
+      public:
+        ChecksumStreambuf(std::streambuf *dest, uint64_t block_size);
+
+        // Return the checksums of all blocks, including the last partial one
+        std::vector<uint32_t> finish();
+        uint64_t size() const { return size_; }
+        uint64_t block_size() const { return block_size_; }
+
+      protected:
+        std::streamsize xsputn(const char *s, std::streamsize n) override;
+        int_type overflow(int_type c) override;
+        int sync() override;
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override;
+
+      private:
+        std::streambuf *dest_;
+        uint64_t block_size_;
+        uint64_t size_ = 0;
+        // the checksum of the bytes written to the current block so far
+        uint32_t checksum_;
+        std::vector<uint32_t> checksums_;
+    };
+
+    std::ostream &out_;
+    std::streambuf *dest_;
+    ChecksumStreambuf buf_;
+    bool finished_ = false;
+};
+
+
+/**
+ * An input stream of the bytes [begin, end) of a file with a BlockTable.
+ * The stream reads up to |read_ahead| blocks ahead in |thread_pool| and
+ * verifies their checksums. A block failing the check ends the stream, which
+ * sets the eof and fail bits, like a truncated file would.
+ */
+class BlockIfstream : public std::istream {
+  public:
+    BlockIfstream(const std::string &filename,
+                  const BlockTable &table,
+                  uint64_t begin,
+                  uint64_t end,
+                  ThreadPool &thread_pool,
+                  size_t read_ahead);
+
+  private:
+    class BlockStreambuf : public std::streambuf {
+      public:
+        BlockStreambuf(const std::string &filename,
+                       const BlockTable &table,
+                       uint64_t begin,
+                       uint64_t end,
+                       ThreadPool &thread_pool,
+                       size_t read_ahead);
+
+      protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+      private:
+        // null if the block couldn't be read or failed the checksum
+        typedef std::shared_ptr<std::vector<char>> Block;
+
+        void seek(uint64_t pos);
+        void schedule_next_block();
+
+        std::string filename_;
+        const BlockTable &table_;
+        uint64_t begin_;
+        uint64_t end_;
+        ThreadPool &thread_pool_;
+        size_t read_ahead_;
+
+        // the position in the file right after the current block
+        uint64_t pos_;
+        // the offset of the block at the front of |pending_|
+        uint64_t front_offset_;
+        // the offset of the next block to schedule
+        uint64_t next_offset_;
+        std::deque<std::shared_future<Block>> pending_;
+        Block block_;
+    };
+
+    BlockStreambuf buf_;
+};
+
+} // namespace common
+} // namespace mtg
+
+#endif // __BLOCK_TABLE_HPP__
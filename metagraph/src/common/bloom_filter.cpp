@@ -180,15 +180,28 @@ batch_insert_avx2(BloomFilter &bloom,
     return hashes_begin;
 }
 
-// Helper for Bloom filter
-// Bit reduce packed 64-bit numbers to 32 bits
-SIMDE_FUNCTION_ATTRIBUTES simde__m128i cvtepi64_epi32(simde__m256i v) {
-    return simde_mm256_castsi256_si128(simde_mm256_permutevar8x32_epi32(
-        v,
-        simde_mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)
-    ));
-}
+// Check all bits of an element at once. Each element sets its bits in a single
+// 512-bit block, so the element is present iff all bits of its mask are set in
+// the block, which is tested with two 256-bit vector operations.
+inline bool check_block(const int64_t *block, uint64_t hash, uint64_t num_hash_functions) {
+    const uint64_t h_hi = hash >> 32;
+    const uint64_t h_lo = hash & 0xFFFFFFFF;
+
+    alignas(32) uint64_t mask[8] = { 0 };
+    for (uint64_t i = 0; i < num_hash_functions; ++i) {
+        uint64_t id = (h_lo * i + h_hi) & BLOCK_MASK;
+        mask[id >> 6] |= 1llu << (id & 0x3F);
+    }
 
+    const simde__m256i *block_cast = reinterpret_cast<const simde__m256i*>(block);
+    const simde__m256i *mask_cast = reinterpret_cast<const simde__m256i*>(mask);
+
+    // testc(a, b) is true iff all bits set in b are also set in a
+    return simde_mm256_testc_si256(simde_mm256_loadu_si256(block_cast),
+                                   simde_mm256_load_si256(mask_cast))
+        && simde_mm256_testc_si256(simde_mm256_loadu_si256(block_cast + 1),
+                                   simde_mm256_load_si256(mask_cast + 1));
+}
 
 // compute Bloom filter hashes in batches of 4
 inline uint64_t
@@ -200,7 +213,6 @@ batch_check_avx2(const BloomFilter &bloom,
     assert(num_hash_functions_);
 
     const int64_t *filter_cast = reinterpret_cast<const int64_t*>(bloom.data().data());
-    const int64_t *offset;
 
     const size_t size = bloom.size();
 
@@ -208,57 +220,37 @@ batch_check_avx2(const BloomFilter &bloom,
     const simde__m256i block_mask_out = simde_mm256_set1_epi64x(BLOCK_MASK_OUT);
     const simde__m256i mod_mask = simde_mm256_set1_epi64x(0x3F);
     const simde__m256i ones = simde_mm256_set1_epi64x(1);
-    const simde__m256i all = simde_mm256_set1_epi64x(0xFFFFFFFFFFFFFFFF);
-    const simde__m256i add = simde_mm256_setr_epi64x(0, 1, 2, 3);
-    const simde__m256i numhash = simde_mm256_set1_epi64x(num_hash_functions_);
+
+    alignas(32) uint64_t block_index_array[4];
+    alignas(32) uint64_t next_block_index_array[4];
+
+    if (hashes_begin + 4 <= hashes_end) {
+        simde_mm256_store_si256(reinterpret_cast<simde__m256i*>(next_block_index_array),
+                                restrict_to_mask_epi64(hashes_begin, size, block_mask_out));
+    }
 
     // check four input elements (represented by hashes) at a time
     size_t i = 0;
     for (; hashes_begin + 4 <= hashes_end; hashes_begin += 4) {
-        simde__m256i block_indices = restrict_to_mask_epi64(hashes_begin, size, block_mask_out);
-        alignas(32) uint64_t block_index_array[4];
-        simde_mm256_store_si256(reinterpret_cast<simde__m256i*>(block_index_array), block_indices);
+        std::copy(next_block_index_array, next_block_index_array + 4, block_index_array);
 
+        // Prefetch the blocks for the next four elements, so that the memory
+        // accesses overlap with checking the current ones
+        if (hashes_begin + 8 <= hashes_end) {
+            simde_mm256_store_si256(reinterpret_cast<simde__m256i*>(next_block_index_array),
+                                    restrict_to_mask_epi64(hashes_begin + 4, size, block_mask_out));
+            for (size_t j = 0; j < 4; ++j) {
+                const int64_t *block = filter_cast + (next_block_index_array[j] >> 6);
+                // the block may be not aligned to a cache line
+                __builtin_prefetch(block, 0);
+                __builtin_prefetch(block + 7, 0);
+            }
+        }
 
         if (num_hash_functions_ > 1) {
             for (size_t j = 0; j < 4; ++j) {
-                simde__m256i h = simde_mm256_set1_epi64x(hashes_begin[j]);
-                simde__m256i h_hi = simde_mm256_srli_epi64(h, 32);
-
-                offset = filter_cast + (block_index_array[j] >> 6);
-
-                // ensure that the entire 512-bit block is cached
-                __builtin_prefetch(offset, 0);
-
-                // compute hash functions four at a time
-                bool found = true;
-                uint32_t k = 0;
-                for (; found && k < num_hash_functions_; k += 4) {
-                    // hash = (h_hi + k * h_lo) & BLOCK_MASK
-                    simde__m256i mult = simde_mm256_add_epi64(simde_mm256_set1_epi64x(k), add);
-                    simde__m256i hash = simde_mm256_and_si256(
-                        simde_mm256_add_epi64(simde_mm256_mul_epu32(h, mult), h_hi),
-                        block_mask
-                    );
-
-                    // test all four hashes
-                    // word = offset[uint32_t(hash / 64)] >> (hash % 64)
-                    // For hash indices greater than num_hash_functions_ - 1,
-                    // fill the word with -1 so that they test true
-                    found &= simde_mm256_testc_si256(
-                        simde_mm256_srlv_epi64(
-                            simde_mm256_mask_i32gather_epi64(
-                                all,
-                                offset,
-                                cvtepi64_epi32(simde_mm256_srli_epi64(hash, 6)),
-                                simde_mm256_cmpgt_epi64(numhash, mult),
-                                8
-                            ),
-                            simde_mm256_and_si256(hash, mod_mask)
-                        ),
-                        ones
-                    );
-                }
+                bool found = check_block(filter_cast + (block_index_array[j] >> 6),
+                                         hashes_begin[j], num_hash_functions_);
 
                 assert(found == bloom.check(hashes_begin[j]));
 
@@ -267,6 +259,9 @@ batch_check_avx2(const BloomFilter &bloom,
             }
 
         } else {
+            simde__m256i block_indices = simde_mm256_load_si256(
+                reinterpret_cast<const simde__m256i*>(block_index_array)
+            );
             // check all four elements in parallel
             simde__m256i hash = simde_mm256_add_epi64(
                 simde_mm256_and_si256(
@@ -0,0 +1,98 @@
+#ifndef __SHARDED_LRU_CACHE_HPP__
+#define __SHARDED_LRU_CACHE_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <cache.hpp>
+#include <lru_cache_policy.hpp>
+
+
+namespace mtg {
+namespace common {
+
+/**
+ * A thread-safe LRU cache split into independent shards by the key hash.
+ * Each shard is guarded by its own mutex, so threads sharing the cache rarely
+ * contend for the same lock. The eviction policy is LRU within each shard.
+ * A cache of size zero never stores anything.
+ */
+template <typename Key, typename Value, class Hash = std::hash<Key>>
+class ShardedLRUCache {
+  public:
+    static constexpr size_t kDefaultNumShards = 64;
+
+    explicit ShardedLRUCache(size_t max_size, size_t num_shards = kDefaultNumShards)
+          : num_shards_(std::min(max_size, num_shards)),
+            shards_(new Shard[num_shards_]) {
+        for (size_t i = 0; i < num_shards_; ++i) {
+            shards_[i].cache = std::make_unique<Cache>((max_size + num_shards_ - 1) / num_shards_);
+        }
+    }
+
+    std::optional<Value> TryGet(const Key &key) const {
+        if (!num_shards_)
+            return std::nullopt;
+
+        Shard &shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mu);
+        if (auto fetch = shard.cache->TryGet(key)) {
+            shard.num_hits.fetch_add(1, std::memory_order_relaxed);
+            return *fetch;
+        }
+        shard.num_misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    void Put(const Key &key, const Value &value) {
+        if (!num_shards_)
+            return;
+
+        Shard &shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mu);
+        shard.cache->Put(key, value);
+    }
+
+    uint64_t num_hits() const {
+        uint64_t result = 0;
+        for (size_t i = 0; i < num_shards_; ++i) {
+            result += shards_[i].num_hits.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    uint64_t num_misses() const {
+        uint64_t result = 0;
+        for (size_t i = 0; i < num_shards_; ++i) {
+            result += shards_[i].num_misses.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+  private:
+    typedef caches::fixed_sized_cache<Key, Value, caches::LRUCachePolicy<Key>> Cache;
+
+    // aligned to keep the counters of different shards in separate cache lines
+    struct alignas(64) Shard {
+        std::mutex mu;
+        std::unique_ptr<Cache> cache;
+        std::atomic<uint64_t> num_hits { 0 };
+        std::atomic<uint64_t> num_misses { 0 };
+    };
+
+    size_t num_shards_;
+    std::unique_ptr<Shard[]> shards_;
+
+    Shard& get_shard(const Key &key) const {
+        return shards_[Hash{}(key) % num_shards_];
+    }
+};
+
+} // namespace common
+} // namespace mtg
+
+#endif // __SHARDED_LRU_CACHE_HPP__
@@ -73,6 +73,25 @@ size_t get_peak_RSS() {
 #endif
 }
 
+/**
+ * Returns the number of pages the process has read from disk so far
+ * (major page faults, e.g., on memory-mapped files), or zero if the
+ * value cannot be determined on this OS.
+ */
+uint64_t get_num_page_ins() {
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+    /* BSD, Linux, and OSX -------------------------------------- */
+    struct rusage rusage;
+    if ( getrusage( RUSAGE_SELF, &rusage ) )
+        return 0;
+    return (uint64_t)rusage.ru_majflt;
+
+#else
+    /* Windows and Unknown OS ----------------------------------- */
+    return 0;                   /* Unsupported. */
+#endif
+}
+
 /**
  * Returns the current resident set size (physical memory use) measured
  * in bytes, or zero if the value cannot be determined on this OS.
@@ -7,6 +7,7 @@
  */
 
 #include <chrono>
+#include <cstdint>
 
 
 bool stderr_to_terminal();
@@ -22,6 +23,12 @@ size_t get_curr_RSS();
  * determined on this OS.
  */
 size_t get_peak_RSS();
+/**
+ * Returns the number of pages the process has read from disk so far
+ * (major page faults, e.g., on memory-mapped files), or zero if the
+ * value cannot be determined on this OS.
+ */
+uint64_t get_num_page_ins();
 
 
 size_t get_max_files_open();
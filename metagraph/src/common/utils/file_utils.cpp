@@ -26,13 +26,14 @@ std::mutex TMP_DIRS_MUTEX;
 
 static bool WITH_MMAP = false;
 
-bool with_mmap(bool set_bit) {
-    if (set_bit) {
-        WITH_MMAP = true;
-    }
+bool with_mmap() {
     return WITH_MMAP;
 }
 
+void set_mmap(bool value) {
+    WITH_MMAP = value;
+}
+
 std::unique_ptr<std::ifstream> open_ifstream(const std::string &filename, bool mmap_stream) {
     std::unique_ptr<std::ifstream> in;
     if (mmap_stream) {
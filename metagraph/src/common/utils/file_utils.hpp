@@ -22,8 +22,9 @@ void remove_temp_dir(std::filesystem::path dir_name);
 
 bool check_if_writable(const std::string &filename);
 
-// Call with_mmap() to check and with_mmap(true) to set. Off by default.
-bool with_mmap(bool set_bit = false);
+// Whether the indexes are loaded with memory mapping. Off by default.
+bool with_mmap();
+void set_mmap(bool value);
 
 std::unique_ptr<std::ifstream>
 open_ifstream(const std::string &filename, bool mmap_stream = with_mmap());
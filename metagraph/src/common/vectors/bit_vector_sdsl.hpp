@@ -10,6 +10,7 @@
 #include <sdsl/bit_vector_il.hpp>
 
 #include "common/serialization.hpp"
+#include "common/threads/threading.hpp"
 #include "vector_algorithm.hpp"
 #include "bit_vector.hpp"
 
@@ -30,13 +31,11 @@ class bit_vector_sdsl : public bit_vector {
     explicit bit_vector_sdsl(uint64_t size = 0, bool value = false)
       : bit_vector_sdsl(sdsl::bit_vector(size, value)) {}
     explicit bit_vector_sdsl(const sdsl::bit_vector &vector)
-      : vector_(vector), rk1_(&vector_), slct1_(&vector_), slct0_(&vector_),
-        num_set_bits_(rk1_(vector_.size())) {}
+      : vector_(vector) { init_support(); }
     explicit bit_vector_sdsl(const bit_vector_sdsl &other) { *this = other; }
 
     bit_vector_sdsl(sdsl::bit_vector&& vector)
-      : vector_(std::move(vector)), rk1_(&vector_), slct1_(&vector_), slct0_(&vector_),
-        num_set_bits_(rk1_(vector_.size())) {}
+      : vector_(std::move(vector)) { init_support(); }
     bit_vector_sdsl(bit_vector_sdsl&& other) { *this = std::move(other); }
     bit_vector_sdsl(std::initializer_list<bool> init)
       : bit_vector_sdsl(sdsl::bit_vector(init)) {}
@@ -86,6 +85,11 @@ class bit_vector_sdsl : public bit_vector {
     }
 
   private:
+    inline void init_support();
+
+    // build the rank and select supports concurrently for vectors this large
+    static constexpr uint64_t kMinSizeParallelSupport = 1llu << 22;
+
     bv_type vector_;
     rank_1_type rk1_;
     select_1_type slct1_;
@@ -94,6 +98,33 @@ class bit_vector_sdsl : public bit_vector {
 };
 
 
+template <class bv_type, class rank_1_type, class select_1_type, class select_0_type>
+void
+bit_vector_sdsl<bv_type, rank_1_type, select_1_type, select_0_type>
+::init_support() {
+    // The supports only read the vector, so they can be built in parallel.
+    // The compressed vectors have their supports precomputed.
+    if (std::is_same_v<bv_type, sdsl::bit_vector>
+            && vector_.size() >= kMinSizeParallelSupport
+            && get_num_threads() > 1) {
+        #pragma omp parallel sections num_threads(2)
+        {
+            #pragma omp section
+            rk1_ = rank_1_type(&vector_);
+            #pragma omp section
+            {
+                slct1_ = select_1_type(&vector_);
+                slct0_ = select_0_type(&vector_);
+            }
+        }
+    } else {
+        rk1_ = rank_1_type(&vector_);
+        slct1_ = select_1_type(&vector_);
+        slct0_ = select_0_type(&vector_);
+    }
+    num_set_bits_ = rk1_(vector_.size());
+}
+
 template <class bv_type, class rank_1_type, class select_1_type, class select_0_type>
 bit_vector_sdsl<bv_type, rank_1_type, select_1_type, select_0_type>&
 bit_vector_sdsl<bv_type, rank_1_type, select_1_type, select_0_type>
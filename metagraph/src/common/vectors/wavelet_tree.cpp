@@ -447,20 +447,41 @@ partite_vector<t_bv>::partite_vector(uint8_t logsigma,
 
     std::vector<sdsl::bit_vector> bitmaps(1 << logsigma);
 
-    for (size_t i = 0; i < int_vector_.size(); ++i) {
-
-        TAlphabet c = int_vector_[i];
+    // only allocate the bitmaps for characters present in the vector
+    std::vector<uint8_t> present(bitmaps.size(), false);
+    #pragma omp parallel num_threads(get_num_threads())
+    {
+        std::vector<uint8_t> present_local(bitmaps.size(), false);
+
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < int_vector_.size(); ++i) {
+            assert(int_vector_[i] < bitmaps.size());
+            present_local[int_vector_[i]] = true;
+        }
 
-        assert(c < static_cast<uint64_t>(bitmaps.size()));
+        #pragma omp critical
+        for (size_t c = 0; c < bitmaps.size(); ++c) {
+            present[c] |= present_local[c];
+        }
+    }
 
-        if (!bitmaps[c].size())
+    #pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic)
+    for (size_t c = 0; c < bitmaps.size(); ++c) {
+        if (present[c])
             bitmaps[c] = sdsl::bit_vector(int_vector_.size(), 0);
+    }
 
-        bitmaps[c][i] = 1;
+    // set the block size to a multiple of 64 to avoid race conditions
+    #pragma omp parallel for num_threads(get_num_threads()) schedule(static, 1024)
+    for (size_t i = 0; i < int_vector_.size(); ++i) {
+        bitmaps[int_vector_[i]][i] = 1;
     }
 
-    for (auto &bv : bitmaps) {
-        bitmaps_.emplace_back(std::move(bv));
+    // the rank and select supports are built for all bitmaps in parallel
+    bitmaps_.resize(bitmaps.size());
+    #pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic)
+    for (size_t c = 0; c < bitmaps.size(); ++c) {
+        bitmaps_[c] = t_bv(std::move(bitmaps[c]));
     }
 }
 
@@ -4,6 +4,7 @@
 #include <cstdlib>
 
 #include "annotation/representation/row_compressed/annotate_row_compressed.hpp"
+#include "annotation/representation/column_compressed/annotate_column_compressed.hpp"
 #include "annotation/int_matrix/base/int_matrix.hpp"
 #include "graph/representation/canonical_dbg.hpp"
 #include "common/aligned_vector.hpp"
@@ -31,6 +32,9 @@ AnnotatedSequenceGraph
       : graph_(graph), annotator_(std::move(annotation)), force_fast_(force_fast) {
     assert(graph_.get());
     assert(annotator_.get());
+    // ColumnCompressed::add_labels is thread-safe
+    concurrent_add_labels_
+        = dynamic_cast<annot::ColumnCompressed<Label>*>(annotator_.get()) != nullptr;
     assert(check_compatibility());
 }
 
@@ -55,6 +59,11 @@ void AnnotatedSequenceGraph
     if (!indices.size())
         return;
 
+    if (concurrent_add_labels_) {
+        annotator_->add_labels(indices, labels);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (force_fast_) {
@@ -86,6 +95,16 @@ void AnnotatedSequenceGraph
         });
     }
 
+    if (concurrent_add_labels_) {
+        // the batches annotated by different threads are inserted into
+        // the column builders concurrently
+        for (size_t t = 0; t < data.size(); ++t) {
+            if (ids[t].size())
+                annotator_->add_labels(ids[t], data[t].second);
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     for (size_t t = 0; t < data.size(); ++t) {
@@ -654,12 +673,14 @@ std::vector<StringCountPair> top_labels(Container&& code_counts,
     std::ignore = min_count;
 
     if (code_counts.size() > num_top_labels) {
-        // sort labels by counts to get the top |num_top_labels|
-        std::sort(code_counts.begin(), code_counts.end(),
-                  [](const auto &x, const auto &y) {
-                      return std::make_pair(y.second, x.first)
-                            < std::make_pair(x.second, y.first);
-                  });
+        // sort only the top |num_top_labels| labels by counts
+        std::partial_sort(code_counts.begin(),
+                          code_counts.begin() + num_top_labels,
+                          code_counts.end(),
+                          [](const auto &x, const auto &y) {
+                              return std::make_pair(y.second, x.first)
+                                    < std::make_pair(x.second, y.first);
+                          });
         // leave only the first |num_top_labels| top labels
         code_counts.resize(num_top_labels);
     }
@@ -63,6 +63,8 @@ class AnnotatedSequenceGraph {
 
     std::mutex mutex_;
     bool force_fast_;
+    // set if |annotator_| supports concurrent calls of add_labels
+    bool concurrent_add_labels_;
 };
 
 
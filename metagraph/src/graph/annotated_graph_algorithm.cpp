@@ -1,8 +1,10 @@
 #include "annotated_graph_algorithm.hpp"
 
+#include "annotation/binary_matrix/column_sparse/column_major.hpp"
 #include "common/logger.hpp"
 #include "common/vectors/vector_algorithm.hpp"
 #include "common/vectors/bitmap.hpp"
+#include "common/vectors/bit_vector_adaptive.hpp"
 #include "graph/representation/masked_graph.hpp"
 
 
@@ -18,6 +20,9 @@ typedef std::function<size_t()> LabelCountCallback;
 
 constexpr std::memory_order MO_RELAXED = std::memory_order_relaxed;
 
+// the number of nodes processed at once when counting the labels
+constexpr uint64_t kCountRangeSize = 1 << 16;
+
 uint64_t atomic_fetch(const sdsl::int_vector<> &vector,
                       uint64_t i,
                       std::mutex &backup_mutex,
@@ -371,27 +376,73 @@ construct_diff_label_count_vector(const AnnotatedDBG &anno_graph,
         label_codes.push_back(code);
     }
 
-    std::mutex vector_backup_mutex;
-    std::atomic_thread_fence(std::memory_order_release);
-    bool parallel = num_threads > 1;
-
-    binmat.call_columns(label_codes,
-        [&](auto col_idx, const bitmap &rows) {
-            uint8_t col_indicator = code_to_indicator[label_codes[col_idx]];
-            rows.call_ones([&](auto r) {
-                node_index i = AnnotatedDBG::anno_to_graph_index(r);
-                set_bit(indicator.data(), i, parallel, MO_RELAXED);
-                if (col_indicator & 1)
-                    atomic_fetch_and_add(counts, i * 2, 1, vector_backup_mutex, MO_RELAXED);
-
-                if (col_indicator & 2)
-                    atomic_fetch_and_add(counts, i * 2 + 1, 1, vector_backup_mutex, MO_RELAXED);
-            });
-        },
-        num_threads
-    );
+    std::vector<uint8_t> col_indicators;
+    col_indicators.reserve(label_codes.size());
+    for (auto code : label_codes) {
+        col_indicators.push_back(code_to_indicator[code]);
+    }
 
-    std::atomic_thread_fence(std::memory_order_acquire);
+    // The counts are updated in parallel over disjoint ranges of nodes, and
+    // each column is visited in every range with call_ones_in_range. The ranges
+    // are aligned to 64 nodes, so the threads never write to the same words and
+    // the counts can be incremented without atomics.
+    auto count_columns = [&](const std::vector<const bitmap *> &columns, size_t offset) {
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (uint64_t range_begin = 0; range_begin < indicator.size();
+                                            range_begin += kCountRangeSize) {
+            uint64_t range_end = std::min(range_begin + kCountRangeSize, indicator.size());
+            for (size_t j = 0; j < columns.size(); ++j) {
+                uint8_t col_indicator = col_indicators[offset + j];
+                // rows are indexed from zero and nodes from one
+                columns[j]->call_ones_in_range(range_begin ? range_begin - 1 : 0,
+                                               range_end - 1, [&](uint64_t r) {
+                    node_index i = AnnotatedDBG::anno_to_graph_index(r);
+                    indicator[i] = true;
+                    if (col_indicator & 1)
+                        counts[i * 2] += 1;
+
+                    if (col_indicator & 2)
+                        counts[i * 2 + 1] += 1;
+                });
+            }
+        }
+    };
+
+    if (const auto *column_major = dynamic_cast<const annot::matrix::ColumnMajor *>(&binmat)) {
+        // the columns are stored explicitly and don't have to be decoded
+        std::vector<const bitmap *> columns;
+        columns.reserve(label_codes.size());
+        for (auto code : label_codes) {
+            columns.push_back(column_major->data()[code].get());
+        }
+        count_columns(columns, 0);
+
+    } else {
+        // The columns are decoded in batches and kept compressed while
+        // the counts are updated.
+        const size_t batch_size = std::max(num_threads, (size_t)1);
+        for (size_t begin = 0; begin < label_codes.size(); begin += batch_size) {
+            size_t end = std::min(begin + batch_size, label_codes.size());
+            std::vector<annot::matrix::BinaryMatrix::Column> batch(label_codes.begin() + begin,
+                                                                   label_codes.begin() + end);
+            std::vector<std::unique_ptr<bit_vector>> decoded(batch.size());
+            binmat.call_columns(batch,
+                [&](auto j, const bitmap &rows) {
+                    decoded[j] = std::make_unique<bit_vector_smart>(
+                        [&](const auto &callback) { rows.call_ones(callback); },
+                        rows.size(), rows.num_set_bits()
+                    );
+                },
+                num_threads
+            );
+
+            std::vector<const bitmap *> columns;
+            for (const auto &column : decoded) {
+                columns.push_back(column.get());
+            }
+            count_columns(columns, begin);
+        }
+    }
 
     return std::make_pair(std::move(counts), std::move(indicator));
 }
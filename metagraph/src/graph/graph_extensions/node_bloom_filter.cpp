@@ -0,0 +1,157 @@
+#include "node_bloom_filter.hpp"
+
+#include <mutex>
+
+#include "common/logger.hpp"
+#include "common/utils/file_utils.hpp"
+#include "common/utils/string_utils.hpp"
+#include "graph/representation/hash/dbg_hash_fast.hpp"
+#include "graph/representation/hash/dbg_hash_ordered.hpp"
+#include "graph/representation/hash/dbg_sshash.hpp"
+
+
+namespace mtg {
+namespace graph {
+
+using mtg::common::logger;
+
+
+NodeBloomFilter::NodeBloomFilter(const DeBruijnGraph &graph,
+                                 double bits_per_kmer,
+                                 double false_positive_rate,
+                                 uint32_t max_num_hash_functions,
+                                 size_t num_threads) {
+    const bool canonical = graph.get_mode() != DeBruijnGraph::BASIC;
+    const uint64_t num_kmers = graph.num_nodes();
+
+    if (false_positive_rate < 1.0) {
+        filter_ = std::make_unique<kmer::KmerBloomFilter<>>(
+            graph.get_k(), canonical,
+            BloomFilter::optim_size(false_positive_rate, num_kmers),
+            num_kmers,
+            std::min(max_num_hash_functions, BloomFilter::optim_h(false_positive_rate))
+        );
+    } else {
+        filter_ = std::make_unique<kmer::KmerBloomFilter<>>(
+            graph.get_k(), canonical,
+            bits_per_kmer * num_kmers,
+            num_kmers,
+            max_num_hash_functions
+        );
+    }
+
+    std::mutex seq_mutex;
+    filter_->add_sequences([&](const auto &callback) {
+        graph.call_sequences(
+            [&](const auto &sequence, const auto &) {
+                std::lock_guard<std::mutex> lock(seq_mutex);
+                callback(sequence);
+            },
+            num_threads,
+            canonical
+        );
+    });
+}
+
+void NodeBloomFilter::map_to_nodes(std::string_view sequence,
+                                   const MapToNodes &map,
+                                   const std::function<void(node_index)> &callback,
+                                   const std::function<bool()> &terminate) const {
+    assert(filter_);
+
+    const size_t k = filter_->get_k();
+    if (sequence.size() < k)
+        return;
+
+    sdsl::bit_vector in_filter = filter_->check_kmer_presence(sequence);
+    assert(in_filter.size() + k - 1 == sequence.size());
+
+    for (size_t i = 0; i < in_filter.size(); ) {
+        if (terminate())
+            return;
+
+        if (!in_filter[i]) {
+            callback(SequenceGraph::npos);
+            ++i;
+            continue;
+        }
+
+        size_t end = i + 1;
+        while (end < in_filter.size() && in_filter[end]) {
+            ++end;
+        }
+
+        map(sequence.substr(i, end - i + k - 1), callback, terminate);
+        i = end;
+    }
+}
+
+void map_to_nodes_with_filter(const NodeBloomFilter *filter,
+                              std::string_view sequence,
+                              const NodeBloomFilter::MapToNodes &map,
+                              const std::function<void(SequenceGraph::node_index)> &callback,
+                              const std::function<bool()> &terminate) {
+    if (filter) {
+        filter->map_to_nodes(sequence, map, callback, terminate);
+    } else {
+        map(sequence, callback, terminate);
+    }
+}
+
+// <prefix>[.<graph extension>] -> <prefix>.bloom
+static std::string get_filename(const std::string &filename_base) {
+    return utils::remove_suffix(filename_base,
+                                DBGHashFast::kExtension,
+                                DBGHashOrdered::kExtension,
+                                DBGSSHash::kExtension)
+                + NodeBloomFilter::kBloomFilterExtension;
+}
+
+bool NodeBloomFilter::load(const std::string &filename_base) {
+    const auto fname = get_filename(filename_base);
+    try {
+        std::unique_ptr<std::ifstream> in = utils::open_ifstream(fname);
+        if (!in->good())
+            return false;
+
+        filter_ = std::make_unique<kmer::KmerBloomFilter<>>(1, false);
+        if (!filter_->load(*in)) {
+            logger->error("Cannot load Bloom filter from file {}", fname);
+            filter_.reset();
+            return false;
+        }
+        return true;
+
+    } catch (...) {
+        return false;
+    }
+}
+
+void NodeBloomFilter::serialize(const std::string &filename_base) const {
+    assert(filter_);
+
+    const auto fname = get_filename(filename_base);
+
+    std::ofstream out = utils::open_new_ofstream(fname);
+    if (!out.good())
+        throw std::ios_base::failure("Can't write to file " + fname);
+
+    filter_->serialize(out);
+}
+
+bool NodeBloomFilter::is_compatible(const SequenceGraph &graph, bool verbose) const {
+    assert(filter_);
+
+    const auto *dbg = dynamic_cast<const DeBruijnGraph *>(&graph);
+    if (dbg && dbg->get_k() == filter_->get_k()
+            && (dbg->get_mode() != DeBruijnGraph::BASIC) == filter_->is_canonical_mode())
+        return true;
+
+    if (verbose)
+        std::cerr << "ERROR: Bloom filter does not match the k or the mode of the graph"
+                  << std::endl;
+    return false;
+}
+
+} // namespace graph
+} // namespace mtg
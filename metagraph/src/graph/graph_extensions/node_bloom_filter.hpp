@@ -0,0 +1,80 @@
+#ifndef __NODE_BLOOM_FILTER_HPP__
+#define __NODE_BLOOM_FILTER_HPP__
+
+#include <string>
+#include <memory>
+#include <functional>
+
+#include "graph/representation/base/sequence_graph.hpp"
+#include "kmer/kmer_bloom_filter.hpp"
+
+
+namespace mtg {
+namespace graph {
+
+/**
+ * A Bloom filter for the k-mers of a graph, used to skip the lookups of
+ * k-mers absent in the graph. Unlike the filter built into DBGSuccinct,
+ * it can extend any graph representation.
+ * In the non-basic modes, the k-mers are inserted in their canonical form,
+ * so that the filter never rejects a k-mer present in either orientation.
+ */
+class NodeBloomFilter : public SequenceGraph::GraphExtension {
+  public:
+    using node_index = typename SequenceGraph::node_index;
+
+    typedef std::function<void(std::string_view,
+                               const std::function<void(node_index)> &,
+                               const std::function<bool()> &)> MapToNodes;
+
+    NodeBloomFilter() {}
+
+    // Insert all k-mers from the graph to a new Bloom filter.
+    // |false_positive_rate|, when < 1, overrides |bits_per_kmer|.
+    NodeBloomFilter(const DeBruijnGraph &graph,
+                    double bits_per_kmer,
+                    double false_positive_rate = 1.0,
+                    uint32_t max_num_hash_functions = -1,
+                    size_t num_threads = 1);
+
+    // Insert the k-mers of |sequence| to the filter
+    void add_sequence(std::string_view sequence) {
+        if (sequence.size() >= filter_->get_k())
+            filter_->add_sequence(sequence);
+    }
+
+    // Map the k-mers of |sequence| with |map|, calling it only on the runs of
+    // k-mers passing the filter. The k-mers rejected by the filter are
+    // reported as npos.
+    void map_to_nodes(std::string_view sequence,
+                      const MapToNodes &map,
+                      const std::function<void(node_index)> &callback,
+                      const std::function<bool()> &terminate = [](){ return false; }) const;
+
+    // The filter is stored in <prefix>.bloom, where <prefix> is |filename_base|
+    // with the graph file extension stripped, same as for DBGSuccinct.
+    bool load(const std::string &filename_base);
+    void serialize(const std::string &filename_base) const;
+
+    bool is_compatible(const SequenceGraph &graph, bool verbose = true) const;
+
+    const kmer::KmerBloomFilter<>& get_filter() const { return *filter_; }
+
+    static constexpr auto kBloomFilterExtension = ".bloom";
+
+  private:
+    std::unique_ptr<kmer::KmerBloomFilter<>> filter_;
+};
+
+// Run |map| on |sequence|, skipping the k-mers rejected by |filter|.
+// Run it on the entire sequence if |filter| is null.
+void map_to_nodes_with_filter(const NodeBloomFilter *filter,
+                              std::string_view sequence,
+                              const NodeBloomFilter::MapToNodes &map,
+                              const std::function<void(SequenceGraph::node_index)> &callback,
+                              const std::function<bool()> &terminate);
+
+} // namespace graph
+} // namespace mtg
+
+#endif // __NODE_BLOOM_FILTER_HPP__
@@ -1,9 +1,7 @@
 #ifndef __NODE_FIRST_CACHE_HPP__
 #define __NODE_FIRST_CACHE_HPP__
 
-#include <cache.hpp>
-#include <lru_cache_policy.hpp>
-
+#include "common/sharded_lru_cache.hpp"
 #include "graph/representation/succinct/dbg_succinct.hpp"
 
 
@@ -14,6 +12,7 @@ namespace graph {
 // to call_incoming_kmers in DBGSuccinct. In addition, it caches the indices
 // corresponding to the reverse complements of the k-1 prefixes and suffixes of
 // each traversed node.
+// The caches are thread-safe, so a single NodeFirstCache can be shared by all threads.
 class NodeFirstCache : public SequenceGraph::GraphExtension {
   public:
     using node_index = typename SequenceGraph::node_index;
@@ -40,6 +39,15 @@ class NodeFirstCache : public SequenceGraph::GraphExtension {
 
     size_t max_size() const { return cache_size_; }
 
+    uint64_t num_hits() const {
+        return first_cache_.num_hits() + prefix_rc_cache_.num_hits()
+                + suffix_rc_cache_.num_hits();
+    }
+    uint64_t num_misses() const {
+        return first_cache_.num_misses() + prefix_rc_cache_.num_misses()
+                + suffix_rc_cache_.num_misses();
+    }
+
   private:
     const DBGSuccinct &dbg_succ_;
     size_t cache_size_;
@@ -47,8 +55,7 @@ class NodeFirstCache : public SequenceGraph::GraphExtension {
     // Maps a BOSS edge e to the pair (bwd(e), bwd^(k-1)(e)), where k is the node
     // size in a BOSS graph.
     // Thus, first_cache_[e] == boss.get_minus_k_value(e, boss.get_k() - 1).first
-    mutable caches::fixed_sized_cache<edge_index, std::pair<edge_index, edge_index>,
-                                      caches::LRUCachePolicy<edge_index>> first_cache_;
+    mutable common::ShardedLRUCache<edge_index, std::pair<edge_index, edge_index>> first_cache_;
 
     // Fetch or compute (bwd(edge), bwd^(k-1)(edge)), then cache the value.
     // If child_hint != 0, then check first_cache_ if child_hint_'s corresponding
@@ -57,10 +64,8 @@ class NodeFirstCache : public SequenceGraph::GraphExtension {
     std::pair<edge_index, edge_index>
     get_parent_pair(edge_index edge, edge_index child_hint = 0) const;
 
-    mutable caches::fixed_sized_cache<edge_index, edge_index,
-                                      caches::LRUCachePolicy<edge_index>> prefix_rc_cache_;
-    mutable caches::fixed_sized_cache<edge_index, edge_index,
-                                      caches::LRUCachePolicy<edge_index>> suffix_rc_cache_;
+    mutable common::ShardedLRUCache<edge_index, edge_index> prefix_rc_cache_;
+    mutable common::ShardedLRUCache<edge_index, edge_index> suffix_rc_cache_;
 };
 
 } // namespace graph
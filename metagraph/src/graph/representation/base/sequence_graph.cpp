@@ -43,6 +43,7 @@ void SequenceGraph::call_nodes(const std::function<void(node_index)> &callback,
 void SequenceGraph::add_extension(std::shared_ptr<GraphExtension> extension) {
     assert(extension.get());
     extensions_.push_back(extension);
+    update_extensions();
 }
 
 void SequenceGraph::serialize_extensions(const std::string &filename) const {
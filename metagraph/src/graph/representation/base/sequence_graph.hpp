@@ -121,6 +121,7 @@ class SequenceGraph {
         for (auto it = extensions_.begin(); it != extensions_.end(); ++it) {
             if (auto match = std::dynamic_pointer_cast<ExtensionSubtype>(*it)) {
                 extensions_.erase(it);
+                update_extensions();
                 return;
             }
         }
@@ -150,6 +151,11 @@ class SequenceGraph {
 
     void serialize_extensions(const std::string &filename_base) const;
 
+  protected:
+    // Called after an extension is added or removed. Override to cache
+    // pointers to the extensions used in the hot paths.
+    virtual void update_extensions() {}
+
   private:
     std::vector<std::shared_ptr<GraphExtension>> extensions_;
 };
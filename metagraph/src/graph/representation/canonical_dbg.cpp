@@ -39,7 +39,7 @@ CanonicalDBG::CanonicalDBG(std::shared_ptr<const DeBruijnGraph> graph, size_t ca
 
     if (const DBGSuccinct *dbg_succ = get_dbg_succ(*graph_)) {
         has_sentinel_ = !dbg_succ->get_mask();
-        fallback_cache_ = std::make_unique<NodeFirstCache>(*dbg_succ, 0);
+        fallback_cache_ = std::make_unique<NodeFirstCache>(*dbg_succ, cache_size_);
     }
 }
 
@@ -52,6 +52,22 @@ NodeFirstCache& CanonicalDBG::get_cache() const {
     return *fallback_cache_;
 }
 
+uint64_t CanonicalDBG::num_cache_hits() const {
+    uint64_t num_hits = is_palindrome_cache_.num_hits();
+    if (fallback_cache_)
+        num_hits += get_cache().num_hits();
+
+    return num_hits;
+}
+
+uint64_t CanonicalDBG::num_cache_misses() const {
+    uint64_t num_misses = is_palindrome_cache_.num_misses();
+    if (fallback_cache_)
+        num_misses += get_cache().num_misses();
+
+    return num_misses;
+}
+
 void CanonicalDBG
 ::map_to_nodes_sequentially(std::string_view sequence,
                             const std::function<void(node_index)> &callback,
@@ -4,9 +4,7 @@
 #include <cassert>
 #include <array>
 
-#include <cache.hpp>
-#include <lru_cache_policy.hpp>
-
+#include "common/sharded_lru_cache.hpp"
 #include "common/vector.hpp"
 #include "graph/representation/base/dbg_wrapper.hpp"
 #include "graph/graph_extensions/node_first_cache.hpp"
@@ -40,6 +38,10 @@ class CanonicalDBG : public DBGWrapper<DeBruijnGraph> {
         return node <= offset_ ? node : node - offset_;
     }
 
+    // Number of lookups answered by the node caches and number of lookups which missed
+    uint64_t num_cache_hits() const;
+    uint64_t num_cache_misses() const;
+
     /**
      * Methods from DeBruijnGraph
      */
@@ -122,8 +124,7 @@ class CanonicalDBG : public DBGWrapper<DeBruijnGraph> {
     const size_t cache_size_;
 
     // cache whether a given node is a palindrome (it's equal to its reverse complement)
-    mutable caches::fixed_sized_cache<node_index, bool,
-                                      caches::LRUCachePolicy<node_index>> is_palindrome_cache_;
+    mutable common::ShardedLRUCache<node_index, bool> is_palindrome_cache_;
 
     const size_t offset_;
     const bool k_odd_;
@@ -131,8 +132,8 @@ class CanonicalDBG : public DBGWrapper<DeBruijnGraph> {
 
     std::array<size_t, 256> alphabet_encoder_;
 
-    // a thread-safe 0-size NodeFirstCache to use as a fallback if another NodeFirstCache
-    // extension is not available
+    // a NodeFirstCache shared by all threads to use as a fallback if another
+    // NodeFirstCache extension is not available
     mutable std::unique_ptr<NodeFirstCache> fallback_cache_;
 
     // Find incoming nodes that are on the reverse complement strand of node
@@ -0,0 +1,328 @@
+#include "delta_dbg.hpp"
+
+#include <mutex>
+
+#include "common/logger.hpp"
+#include "graph/representation/hash/dbg_hash_fast.hpp"
+#include "graph/representation/succinct/boss_construct.hpp"
+#include "graph/representation/succinct/dbg_succinct.hpp"
+
+
+namespace mtg {
+namespace graph {
+
+using mtg::common::logger;
+
+const size_t kCompactionBatchSize = 100'000;
+
+
+DeltaDBG::DeltaDBG(std::shared_ptr<const DeBruijnGraph> base)
+      : base_(std::move(base)),
+        delta_(std::make_unique<DBGHashFast>(base_->get_k(), base_->get_mode())),
+        offset_(base_->max_index()) {
+    if (base_->get_mode() == PRIMARY)
+        throw std::runtime_error("Primary graphs cannot be extended with a delta graph");
+}
+
+DeltaDBG::~DeltaDBG() {}
+
+const DeBruijnGraph& DeltaDBG::get_delta_graph() const { return *delta_; }
+
+void DeltaDBG::add_sequence(std::string_view sequence,
+                            const std::function<void(node_index)> &on_insertion) {
+    std::vector<node_index> nodes = graph::map_to_nodes(*base_, sequence);
+
+    // insert the runs of k-mers missing in the base graph
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i])
+            continue;
+
+        size_t end = i + 1;
+        while (end < nodes.size() && !nodes[end]) {
+            ++end;
+        }
+
+        delta_->add_sequence(sequence.substr(i, end - i + get_k() - 1),
+                             [&](node_index node) { on_insertion(node + offset_); });
+        i = end;
+    }
+}
+
+void DeltaDBG::map_missing_to_delta(std::string_view sequence,
+                                    std::vector<node_index> *nodes,
+                                    bool sequentially) const {
+    if (!delta_->num_nodes())
+        return;
+
+    for (size_t i = 0; i < nodes->size(); ++i) {
+        if ((*nodes)[i])
+            continue;
+
+        size_t end = i + 1;
+        while (end < nodes->size() && !(*nodes)[end]) {
+            ++end;
+        }
+
+        std::string_view run = sequence.substr(i, end - i + get_k() - 1);
+        size_t j = i;
+        auto callback = [&](node_index node) {
+            assert(j < end);
+            if (node)
+                (*nodes)[j] = node + offset_;
+            ++j;
+        };
+        if (sequentially) {
+            delta_->map_to_nodes_sequentially(run, callback);
+        } else {
+            delta_->map_to_nodes(run, callback);
+        }
+        assert(j == end);
+        i = end;
+    }
+}
+
+void DeltaDBG::map_to_nodes(std::string_view sequence,
+                            const std::function<void(node_index)> &callback,
+                            const std::function<bool()> &terminate) const {
+    std::vector<node_index> nodes = graph::map_to_nodes(*base_, sequence);
+    map_missing_to_delta(sequence, &nodes, false);
+
+    for (node_index node : nodes) {
+        if (terminate())
+            return;
+
+        callback(node);
+    }
+}
+
+void DeltaDBG::map_to_nodes_sequentially(std::string_view sequence,
+                                         const std::function<void(node_index)> &callback,
+                                         const std::function<bool()> &terminate) const {
+    std::vector<node_index> nodes = graph::map_to_nodes_sequentially(*base_, sequence);
+    map_missing_to_delta(sequence, &nodes, true);
+
+    for (node_index node : nodes) {
+        if (terminate())
+            return;
+
+        callback(node);
+    }
+}
+
+DeltaDBG::node_index DeltaDBG::kmer_to_node(std::string_view kmer) const {
+    if (node_index node = base_->kmer_to_node(kmer))
+        return node;
+
+    if (!delta_->num_nodes())
+        return npos;
+
+    node_index node = delta_->kmer_to_node(kmer);
+    return node ? node + offset_ : npos;
+}
+
+void DeltaDBG::call_outgoing_kmers(node_index node,
+                                   const OutgoingEdgeCallback &callback) const {
+    assert(in_graph(node));
+
+    if (node <= offset_) {
+        base_->call_outgoing_kmers(node, callback);
+        if (!delta_->num_nodes())
+            return;
+
+        // a k-mer is stored in exactly one layer, so the edges do not repeat
+        std::string kmer = base_->get_node_sequence(node).substr(1) + ' ';
+        for (char c : delta_->alphabet()) {
+            kmer.back() = c;
+            if (node_index next = delta_->kmer_to_node(kmer))
+                callback(next + offset_, c);
+        }
+    } else {
+        delta_->call_outgoing_kmers(node - offset_, [&](node_index next, char c) {
+            callback(next + offset_, c);
+        });
+
+        std::string kmer = delta_->get_node_sequence(node - offset_).substr(1) + ' ';
+        for (char c : delta_->alphabet()) {
+            kmer.back() = c;
+            if (node_index next = base_->kmer_to_node(kmer))
+                callback(next, c);
+        }
+    }
+}
+
+void DeltaDBG::call_incoming_kmers(node_index node,
+                                   const IncomingEdgeCallback &callback) const {
+    assert(in_graph(node));
+
+    if (node <= offset_) {
+        base_->call_incoming_kmers(node, callback);
+        if (!delta_->num_nodes())
+            return;
+
+        std::string kmer = ' ' + base_->get_node_sequence(node);
+        kmer.pop_back();
+        for (char c : delta_->alphabet()) {
+            kmer.front() = c;
+            if (node_index prev = delta_->kmer_to_node(kmer))
+                callback(prev + offset_, c);
+        }
+    } else {
+        delta_->call_incoming_kmers(node - offset_, [&](node_index prev, char c) {
+            callback(prev + offset_, c);
+        });
+
+        std::string kmer = ' ' + delta_->get_node_sequence(node - offset_);
+        kmer.pop_back();
+        for (char c : delta_->alphabet()) {
+            kmer.front() = c;
+            if (node_index prev = base_->kmer_to_node(kmer))
+                callback(prev, c);
+        }
+    }
+}
+
+DeltaDBG::node_index DeltaDBG::traverse(node_index node, char next_char) const {
+    assert(in_graph(node));
+
+    if (node <= offset_) {
+        if (node_index next = base_->traverse(node, next_char))
+            return next;
+
+        if (!delta_->num_nodes())
+            return npos;
+
+        std::string kmer = base_->get_node_sequence(node).substr(1) + next_char;
+        node_index next = delta_->kmer_to_node(kmer);
+        return next ? next + offset_ : npos;
+    }
+
+    if (node_index next = delta_->traverse(node - offset_, next_char))
+        return next + offset_;
+
+    return base_->kmer_to_node(delta_->get_node_sequence(node - offset_).substr(1)
+                                + next_char);
+}
+
+DeltaDBG::node_index DeltaDBG::traverse_back(node_index node, char prev_char) const {
+    assert(in_graph(node));
+
+    if (node <= offset_) {
+        if (node_index prev = base_->traverse_back(node, prev_char))
+            return prev;
+
+        if (!delta_->num_nodes())
+            return npos;
+
+        std::string kmer = prev_char + base_->get_node_sequence(node);
+        kmer.pop_back();
+        node_index prev = delta_->kmer_to_node(kmer);
+        return prev ? prev + offset_ : npos;
+    }
+
+    if (node_index prev = delta_->traverse_back(node - offset_, prev_char))
+        return prev + offset_;
+
+    std::string kmer = prev_char + delta_->get_node_sequence(node - offset_);
+    kmer.pop_back();
+    return base_->kmer_to_node(kmer);
+}
+
+size_t DeltaDBG::outdegree(node_index node) const {
+    if (node <= offset_ && !delta_->num_nodes())
+        return base_->outdegree(node);
+
+    size_t outdegree = 0;
+    call_outgoing_kmers(node, [&](node_index, char) { outdegree++; });
+    return outdegree;
+}
+
+size_t DeltaDBG::indegree(node_index node) const {
+    if (node <= offset_ && !delta_->num_nodes())
+        return base_->indegree(node);
+
+    size_t indegree = 0;
+    call_incoming_kmers(node, [&](node_index, char) { indegree++; });
+    return indegree;
+}
+
+void DeltaDBG::call_nodes(const std::function<void(node_index)> &callback,
+                          const std::function<bool()> &stop_early,
+                          size_t num_threads,
+                          size_t batch_size) const {
+    base_->call_nodes(callback, stop_early, num_threads, batch_size);
+
+    if (stop_early())
+        return;
+
+    delta_->call_nodes([&](node_index node) { callback(node + offset_); },
+                       stop_early, num_threads, batch_size);
+}
+
+uint64_t DeltaDBG::num_nodes() const {
+    return base_->num_nodes() + delta_->num_nodes();
+}
+
+uint64_t DeltaDBG::max_index() const {
+    return offset_ + delta_->max_index();
+}
+
+bool DeltaDBG::in_graph(node_index node) const {
+    return node <= offset_ ? base_->in_graph(node) : delta_->in_graph(node - offset_);
+}
+
+std::string DeltaDBG::get_node_sequence(node_index node) const {
+    assert(in_graph(node));
+
+    return node <= offset_ ? base_->get_node_sequence(node)
+                           : delta_->get_node_sequence(node - offset_);
+}
+
+bool DeltaDBG::load(const std::string &filename_base) {
+    if (!delta_->load(filename_base))
+        return false;
+
+    if (delta_->get_k() != base_->get_k() || delta_->get_mode() != base_->get_mode()) {
+        logger->error("The delta graph is incompatible with the base graph");
+        return false;
+    }
+
+    return true;
+}
+
+void DeltaDBG::serialize(const std::string &filename_base) const {
+    delta_->serialize(filename_base);
+}
+
+std::string DeltaDBG::file_extension() const {
+    return delta_->file_extension();
+}
+
+std::shared_ptr<DBGSuccinct> DeltaDBG::compact(size_t num_threads) const {
+    boss::BOSSConstructor constructor(get_k() - 1, get_mode() == CANONICAL,
+                                      0, "", num_threads);
+
+    std::mutex mu;
+    std::vector<std::string> contigs;
+    auto add_contig = [&](const std::string &contig, const auto &) {
+        std::lock_guard<std::mutex> lock(mu);
+        contigs.push_back(contig);
+        if (contigs.size() >= kCompactionBatchSize) {
+            constructor.add_sequences(std::move(contigs));
+            contigs.clear();
+        }
+    };
+
+    // the constructor adds the reverse complements in canonical mode
+    bool kmers_in_single_form = get_mode() == CANONICAL;
+    base_->call_sequences(add_contig, num_threads, kmers_in_single_form);
+    delta_->call_sequences(add_contig, num_threads, kmers_in_single_form);
+    constructor.add_sequences(std::move(contigs));
+
+    logger->trace("Compacting a graph with {} base and {} delta k-mers",
+                  base_->num_nodes(), delta_->num_nodes());
+
+    return std::make_shared<DBGSuccinct>(new boss::BOSS(&constructor), get_mode());
+}
+
+} // namespace graph
+} // namespace mtg
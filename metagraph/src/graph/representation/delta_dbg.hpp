@@ -0,0 +1,117 @@
+#ifndef __DELTA_DBG_HPP__
+#define __DELTA_DBG_HPP__
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "graph/representation/base/sequence_graph.hpp"
+
+
+namespace mtg {
+namespace graph {
+
+class DBGHashFast;
+class DBGSuccinct;
+
+/**
+ * A static base graph extended with a small dynamic delta graph.
+ *
+ * New k-mers are inserted into the delta graph (a DBGHashFast), while the base
+ * graph is never modified. The nodes of the base graph keep their indexes
+ * [1,...,base.max_index()] and the nodes of the delta graph are indexed after
+ * them, so node indexes stay stable under insertions. Each k-mer is stored
+ * in exactly one of the two layers.
+ *
+ * Once the delta graph grows large, call compact() to fold both layers into a
+ * new static graph. Since compaction does not modify this graph, the caller may
+ * run it in a separate thread while this graph is queried, but not while it is
+ * extended.
+ *
+ * Limitations:
+ *  - compact() is synchronous, it's up to the caller to schedule it and to
+ *    swap in the compacted graph.
+ *  - compaction renumbers all nodes, so the annotation has to be rebuilt or
+ *    remapped for the compacted graph.
+ *  - DeltaDBG isn't exposed in the command line interface.
+ */
+class DeltaDBG : public DeBruijnGraph {
+  public:
+    // The base graph must be in BASIC or CANONICAL mode
+    explicit DeltaDBG(std::shared_ptr<const DeBruijnGraph> base);
+
+    virtual ~DeltaDBG();
+
+    // Insert to the delta graph all k-mers of |sequence| missing in the base
+    // graph. The callback is invoked for the new node indexes.
+    virtual void add_sequence(std::string_view sequence,
+                              const std::function<void(node_index)> &on_insertion = [](node_index) {}) override;
+
+    virtual void map_to_nodes(std::string_view sequence,
+                              const std::function<void(node_index)> &callback,
+                              const std::function<bool()> &terminate = [](){ return false; }) const override;
+
+    virtual void map_to_nodes_sequentially(std::string_view sequence,
+                                           const std::function<void(node_index)> &callback,
+                                           const std::function<bool()> &terminate = [](){ return false; }) const override;
+
+    virtual node_index kmer_to_node(std::string_view kmer) const override;
+
+    virtual void call_outgoing_kmers(node_index node,
+                                     const OutgoingEdgeCallback &callback) const override;
+
+    virtual void call_incoming_kmers(node_index node,
+                                     const IncomingEdgeCallback &callback) const override;
+
+    virtual node_index traverse(node_index node, char next_char) const override;
+    virtual node_index traverse_back(node_index node, char prev_char) const override;
+
+    virtual size_t outdegree(node_index node) const override;
+    virtual size_t indegree(node_index node) const override;
+
+    virtual void call_nodes(const std::function<void(node_index)> &callback,
+                            const std::function<bool()> &stop_early = [](){ return false; },
+                            size_t num_threads = 1,
+                            size_t batch_size = 1'000'000) const override;
+
+    virtual uint64_t num_nodes() const override;
+    virtual uint64_t max_index() const override;
+    virtual bool in_graph(node_index node) const override;
+
+    virtual std::string get_node_sequence(node_index node) const override;
+
+    virtual size_t get_k() const override { return base_->get_k(); }
+    virtual Mode get_mode() const override { return base_->get_mode(); }
+    virtual const std::string& alphabet() const override { return base_->alphabet(); }
+
+    // Only the delta graph is serialized, the base graph is stored separately
+    virtual bool load(const std::string &filename_base) override;
+    virtual void serialize(const std::string &filename_base) const override;
+    virtual std::string file_extension() const override;
+
+    // Build a new static graph with the k-mers from both layers in the calling
+    // thread. All nodes are renumbered, the node indexes of the new graph differ
+    // from the indexes in this graph (also for the base nodes).
+    std::shared_ptr<DBGSuccinct> compact(size_t num_threads = 1) const;
+
+    const DeBruijnGraph& get_base_graph() const { return *base_; }
+    const DeBruijnGraph& get_delta_graph() const;
+
+    bool is_base_node(node_index node) const { return node <= offset_; }
+
+  private:
+    std::shared_ptr<const DeBruijnGraph> base_;
+    std::unique_ptr<DBGHashFast> delta_;
+    // the base graph is never modified, so the offset of the delta nodes is fixed
+    const node_index offset_;
+
+    // map to the delta graph the k-mers not found in the base graph
+    void map_missing_to_delta(std::string_view sequence,
+                              std::vector<node_index> *nodes,
+                              bool sequentially) const;
+};
+
+} // namespace graph
+} // namespace mtg
+
+#endif // __DELTA_DBG_HPP__
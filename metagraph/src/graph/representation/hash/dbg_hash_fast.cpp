@@ -10,6 +10,7 @@
 #include "common/vector_set.hpp"
 #include "common/utils/string_utils.hpp"
 #include "common/logger.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 #include "kmer/kmer_extractor.hpp"
 
 
@@ -580,6 +581,41 @@ DBGHashFast::initialize_graph(size_t k,
     }
 }
 
+void DBGHashFast::add_sequence(std::string_view sequence,
+                               const std::function<void(node_index)> &on_insertion) {
+    hash_dbg_->add_sequence(sequence, on_insertion);
+
+    // keep the Bloom filter free of false negatives
+    if (bloom_filter_)
+        bloom_filter_->add_sequence(sequence);
+}
+
+void DBGHashFast::map_to_nodes(std::string_view sequence,
+                               const std::function<void(node_index)> &callback,
+                               const std::function<bool()> &terminate) const {
+    map_to_nodes_with_filter(bloom_filter_, sequence,
+        [&](std::string_view seq, const auto&... args) {
+            hash_dbg_->map_to_nodes(seq, args...);
+        },
+        callback, terminate
+    );
+}
+
+void DBGHashFast::map_to_nodes_sequentially(std::string_view sequence,
+                                            const std::function<void(node_index)> &callback,
+                                            const std::function<bool()> &terminate) const {
+    map_to_nodes_with_filter(bloom_filter_, sequence,
+        [&](std::string_view seq, const auto&... args) {
+            hash_dbg_->map_to_nodes_sequentially(seq, args...);
+        },
+        callback, terminate
+    );
+}
+
+void DBGHashFast::update_extensions() {
+    bloom_filter_ = get_extension_threadsafe<NodeBloomFilter>();
+}
+
 bool DBGHashFast::load(std::istream &in) {
     if (!in.good())
         return false;
@@ -9,6 +9,8 @@
 namespace mtg {
 namespace graph {
 
+class NodeBloomFilter;
+
 class DBGHashFast : public DeBruijnGraph {
   public:
     DBGHashFast(size_t k,
@@ -23,17 +25,13 @@ class DBGHashFast : public DeBruijnGraph {
     // all new real nodes and all new dummy node indexes allocated in graph.
     // In short: max_index[after] = max_index[before] + {num_invocations}.
     void add_sequence(std::string_view sequence,
-                      const std::function<void(node_index)> &on_insertion = [](node_index) {}) override final {
-        hash_dbg_->add_sequence(sequence, on_insertion);
-    }
+                      const std::function<void(node_index)> &on_insertion = [](node_index) {}) override final;
 
     // Traverse graph mapping sequence to the graph nodes
     // and run callback for each node until the termination condition is satisfied
     void map_to_nodes(std::string_view sequence,
                       const std::function<void(node_index)> &callback,
-                      const std::function<bool()> &terminate = [](){ return false; }) const override final {
-        hash_dbg_->map_to_nodes(sequence, callback, terminate);
-    }
+                      const std::function<bool()> &terminate = [](){ return false; }) const override final;
 
     // Traverse graph mapping sequence to the graph nodes
     // and run callback for each node until the termination condition is satisfied.
@@ -41,9 +39,7 @@ class DBGHashFast : public DeBruijnGraph {
     // In canonical mode, non-canonical k-mers are NOT mapped to canonical ones
     void map_to_nodes_sequentially(std::string_view sequence,
                                    const std::function<void(node_index)> &callback,
-                                   const std::function<bool()> &terminate = [](){ return false; }) const override final {
-        hash_dbg_->map_to_nodes_sequentially(sequence, callback, terminate);
-    }
+                                   const std::function<bool()> &terminate = [](){ return false; }) const override final;
 
     void call_nodes(const std::function<void(node_index)> &callback,
                     const std::function<bool()> &stop_early = [](){ return false; },
@@ -125,11 +121,16 @@ class DBGHashFast : public DeBruijnGraph {
         const std::string& alphabet() const = 0;
     };
 
+  protected:
+    void update_extensions() override;
+
   private:
     static std::unique_ptr<DBGHashFastInterface>
     initialize_graph(size_t k, Mode mode, bool packed_serialization);
 
     std::unique_ptr<DBGHashFastInterface> hash_dbg_;
+    // cached pointer to the NodeBloomFilter extension, if any
+    NodeBloomFilter *bloom_filter_ = nullptr;
 };
 
 } // namespace graph
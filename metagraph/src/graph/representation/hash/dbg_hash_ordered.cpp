@@ -3,12 +3,15 @@
 #include <cassert>
 #include <fstream>
 
+#include <omp.h>
+#include <ips4o.hpp>
 #include <tsl/ordered_set.h>
 
 #include "common/seq_tools/reverse_complement.hpp"
 #include "common/serialization.hpp"
 #include "common/hashers/hash.hpp"
 #include "common/logger.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 #include "kmer/kmer_extractor.hpp"
 
 
@@ -43,6 +46,10 @@ class DBGHashOrderedImpl : public DBGHashOrdered::DBGHashOrderedInterface {
                       const std::function<bool()> &skip,
                       const std::function<void(node_index)> &on_insertion);
 
+    void add_sequences(const std::vector<std::string> &sequences,
+                       const DBGHashOrdered::SkipperGenerator &get_skipper,
+                       size_t num_threads);
+
     // Traverse graph mapping sequence to the graph nodes
     // and run callback for each node until the termination condition is satisfied
     void map_to_nodes(std::string_view sequence,
@@ -176,6 +183,63 @@ void DBGHashOrderedImpl<KMER>::add_sequence(std::string_view sequence,
     }
 }
 
+template <typename KMER>
+void DBGHashOrderedImpl<KMER>::add_sequences(const std::vector<std::string> &sequences,
+                                             const DBGHashOrdered::SkipperGenerator &get_skipper,
+                                             size_t num_threads) {
+    num_threads = std::max(num_threads, (size_t)1);
+    std::vector<std::vector<Kmer>> thread_kmers(num_threads);
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        std::string_view sequence = sequences[i];
+        if (sequence.size() < get_k())
+            continue;
+
+        auto &kmers = thread_kmers[omp_get_thread_num()];
+        auto skip = get_skipper(sequence);
+        std::vector<bool> skipped;
+        skipped.reserve(sequence.size() - get_k() + 1);
+
+        for (const auto &[kmer, in_graph] : sequence_to_kmers(sequence)) {
+            skipped.push_back(skip() || !in_graph);
+            if (!skipped.back())
+                kmers.push_back(kmer);
+        }
+
+        if (mode_ != CANONICAL)
+            continue;
+
+        std::string rev_comp(sequence.begin(), sequence.end());
+        reverse_complement(rev_comp.begin(), rev_comp.end());
+
+        auto it = skipped.end();
+        for (const auto &[kmer, in_graph] : sequence_to_kmers(rev_comp)) {
+            if (!*(--it))
+                kmers.push_back(kmer);
+        }
+    }
+
+    size_t num_kmers = 0;
+    for (const auto &kmers : thread_kmers) {
+        num_kmers += kmers.size();
+    }
+    std::vector<Kmer> kmers;
+    kmers.reserve(num_kmers);
+    for (auto &buffer : thread_kmers) {
+        kmers.insert(kmers.end(), buffer.begin(), buffer.end());
+        buffer = std::vector<Kmer>();
+    }
+
+    ips4o::parallel::sort(kmers.begin(), kmers.end(), std::less<Kmer>(), num_threads);
+    kmers.erase(std::unique(kmers.begin(), kmers.end()), kmers.end());
+
+    kmers_.reserve(kmers_.size() + kmers.size());
+    for (const Kmer &kmer : kmers) {
+        kmers_.insert(kmer);
+    }
+}
+
 // Traverse graph mapping sequence to the graph nodes
 // and run callback for each node until the termination condition is satisfied.
 // Guarantees that nodes are called in the same order as the input sequence.
@@ -598,6 +662,63 @@ DBGHashOrdered::DBGHashOrdered(size_t k,
     hash_dbg_ = initialize_graph(k, mode, packed_serialization);
 }
 
+void DBGHashOrdered::add_sequence(std::string_view sequence,
+                                  const std::function<void(node_index)> &on_insertion) {
+    hash_dbg_->add_sequence(sequence, on_insertion);
+
+    // keep the Bloom filter free of false negatives
+    if (bloom_filter_)
+        bloom_filter_->add_sequence(sequence);
+}
+
+void DBGHashOrdered::add_sequence(std::string_view sequence,
+                                  const std::function<bool()> &skip,
+                                  const std::function<void(node_index)> &on_insertion) {
+    hash_dbg_->add_sequence(sequence, skip, on_insertion);
+
+    // the skipped k-mers are inserted too, which only adds false positives
+    if (bloom_filter_)
+        bloom_filter_->add_sequence(sequence);
+}
+
+void DBGHashOrdered::add_sequences(const std::vector<std::string> &sequences,
+                                   const SkipperGenerator &get_skipper,
+                                   size_t num_threads) {
+    hash_dbg_->add_sequences(sequences, get_skipper, num_threads);
+
+    if (bloom_filter_) {
+        for (const auto &sequence : sequences) {
+            bloom_filter_->add_sequence(sequence);
+        }
+    }
+}
+
+void DBGHashOrdered::map_to_nodes(std::string_view sequence,
+                                  const std::function<void(node_index)> &callback,
+                                  const std::function<bool()> &terminate) const {
+    map_to_nodes_with_filter(bloom_filter_, sequence,
+        [&](std::string_view seq, const auto&... args) {
+            hash_dbg_->map_to_nodes(seq, args...);
+        },
+        callback, terminate
+    );
+}
+
+void DBGHashOrdered::map_to_nodes_sequentially(std::string_view sequence,
+                                               const std::function<void(node_index)> &callback,
+                                               const std::function<bool()> &terminate) const {
+    map_to_nodes_with_filter(bloom_filter_, sequence,
+        [&](std::string_view seq, const auto&... args) {
+            hash_dbg_->map_to_nodes_sequentially(seq, args...);
+        },
+        callback, terminate
+    );
+}
+
+void DBGHashOrdered::update_extensions() {
+    bloom_filter_ = get_extension_threadsafe<NodeBloomFilter>();
+}
+
 bool DBGHashOrdered::load(std::istream &in) {
     if (!in.good())
         return false;
@@ -9,6 +9,8 @@
 namespace mtg {
 namespace graph {
 
+class NodeBloomFilter;
+
 class DBGHashOrdered : public DeBruijnGraph {
   public:
     explicit DBGHashOrdered(size_t k,
@@ -18,9 +20,7 @@ class DBGHashOrdered : public DeBruijnGraph {
     // Insert sequence to graph and invoke callback |on_insertion| for each new
     // node created in the graph.
     void add_sequence(std::string_view sequence,
-                      const std::function<void(node_index)> &on_insertion = [](node_index) {}) {
-        hash_dbg_->add_sequence(sequence, on_insertion);
-    }
+                      const std::function<void(node_index)> &on_insertion = [](node_index) {});
 
     // Insert sequence to graph and invoke callback |on_insertion| for each new
     // node created in the graph.
@@ -28,17 +28,23 @@ class DBGHashOrdered : public DeBruijnGraph {
     // is skipped if `skip()` returns `false`.
     void add_sequence(std::string_view sequence,
                       const std::function<bool()> &skip,
-                      const std::function<void(node_index)> &on_insertion = [](node_index) {}) {
-        hash_dbg_->add_sequence(sequence, skip, on_insertion);
-    }
+                      const std::function<void(node_index)> &on_insertion = [](node_index) {});
+
+    // Returns a function `skip` as in add_sequence for the given sequence
+    typedef std::function<std::function<bool()>(std::string_view)> SkipperGenerator;
+
+    // Insert the k-mers of all sequences to graph in their sorted order, so
+    // that the node indexes don't depend on the order of the sequences.
+    // The k-mers are extracted and sorted in |num_threads|.
+    void add_sequences(const std::vector<std::string> &sequences,
+                       const SkipperGenerator &get_skipper,
+                       size_t num_threads = 1);
 
     // Traverse graph mapping sequence to the graph nodes
     // and run callback for each node until the termination condition is satisfied
     void map_to_nodes(std::string_view sequence,
                       const std::function<void(node_index)> &callback,
-                      const std::function<bool()> &terminate = [](){ return false; }) const {
-        hash_dbg_->map_to_nodes(sequence, callback, terminate);
-    }
+                      const std::function<bool()> &terminate = [](){ return false; }) const;
 
     // Traverse graph mapping sequence to the graph nodes
     // and run callback for each node until the termination condition is satisfied.
@@ -46,9 +52,7 @@ class DBGHashOrdered : public DeBruijnGraph {
     // In canonical mode, non-canonical k-mers are NOT mapped to canonical ones
     void map_to_nodes_sequentially(std::string_view sequence,
                                    const std::function<void(node_index)> &callback,
-                                   const std::function<bool()> &terminate = [](){ return false; }) const {
-        hash_dbg_->map_to_nodes_sequentially(sequence, callback, terminate);
-    }
+                                   const std::function<bool()> &terminate = [](){ return false; }) const;
 
     void call_outgoing_kmers(node_index node,
                              const OutgoingEdgeCallback &callback) const {
@@ -118,6 +122,9 @@ class DBGHashOrdered : public DeBruijnGraph {
         virtual void add_sequence(std::string_view sequence,
                                   const std::function<bool()> &skip,
                                   const std::function<void(node_index)> &on_insertion) = 0;
+        virtual void add_sequences(const std::vector<std::string> &sequences,
+                                   const SkipperGenerator &get_skipper,
+                                   size_t num_threads) = 0;
         virtual void serialize(std::ostream &out) const = 0;
         virtual void serialize(const std::string &filename) const = 0;
         virtual bool load(std::istream &in) = 0;
@@ -125,11 +132,16 @@ class DBGHashOrdered : public DeBruijnGraph {
         const std::string& alphabet() const = 0;
     };
 
+  protected:
+    void update_extensions() override;
+
   private:
     static std::unique_ptr<DBGHashOrderedInterface>
     initialize_graph(size_t k, Mode mode, bool packed_serialization);
 
     std::unique_ptr<DBGHashOrderedInterface> hash_dbg_;
+    // cached pointer to the NodeBloomFilter extension, if any
+    NodeBloomFilter *bloom_filter_ = nullptr;
 };
 
 } // namespace graph
@@ -1,5 +1,6 @@
 #include "dbg_sshash.hpp"
 
+#include <mutex>
 #include <type_traits>
 
 #include <streaming_query.hpp>
@@ -16,6 +17,8 @@
 #include "common/logger.hpp"
 #include "common/algorithms.hpp"
 #include "common/threads/threading.hpp"
+#include "common/utils/file_utils.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 #include "kmer/kmer_extractor.hpp"
 
 
@@ -169,10 +172,76 @@ std::pair<bit_vector_smart, bit_vector_smart> generate_succ_pred(const DBGSSHash
 
 DBGSSHash::DBGSSHash(const std::string& input_filename, size_t k, Mode mode, size_t num_chars)
     : DBGSSHash(k, mode) {
+    build(input_filename, num_chars);
+}
+
+DBGSSHash::DBGSSHash(const std::function<void(const CallSequence&)>& generate_sequences,
+                     size_t k,
+                     Mode mode,
+                     size_t num_chars,
+                     const std::string& tmp_dir)
+    : DBGSSHash(k, mode) {
+    // the SSHash builder reads its input from a file, so spool the sequences
+    utils::TempFile tmp_file(tmp_dir);
+    std::ofstream &out = tmp_file.ofstream();
+
+    size_t total_chars = 0;
+    generate_sequences([&](std::string_view sequence) {
+        if (sequence.size() < k)
+            return;
+
+        out << ">\n" << sequence << "\n";
+        total_chars += sequence.size();
+    });
+    out.flush();
+
+    if (!out.good())
+        throw std::ios_base::failure("Can't write to file " + tmp_file.name());
+
+    if (!total_chars)
+        return;
+
+    build(tmp_file.name(), num_chars ? num_chars : total_chars);
+}
+
+DBGSSHash::DBGSSHash(const DeBruijnGraph& source, size_t num_threads, const std::string& tmp_dir)
+    : DBGSSHash([&](const CallSequence& callback) {
+                    std::mutex seq_mutex;
+                    source.call_unitigs([&](const std::string& unitig, const auto&) {
+                                            std::lock_guard<std::mutex> lock(seq_mutex);
+                                            callback(unitig);
+                                        },
+                                        num_threads, 1, source.get_mode() != BASIC);
+                },
+                source.get_k(),
+                source.get_mode(),
+                0,
+                tmp_dir) {}
+
+std::vector<DBGSSHash::node_index>
+DBGSSHash::map_nodes_from(const DeBruijnGraph& source, size_t num_threads) const {
+    if (source.get_k() != k_)
+        throw std::invalid_argument("The graphs have different k");
+
+    std::vector<node_index> mapping(source.max_index() + 1, npos);
+
+    // every node is written by a single thread
+    source.call_nodes([&](node_index node) {
+        // map_to_nodes also rejects the k-mers with invalid characters
+        map_to_nodes(source.get_node_sequence(node),
+                     [&](node_index mapped) { mapping[node] = mapped; });
+    }, []() { return false; }, num_threads);
+
+    return mapping;
+}
+
+void DBGSSHash::build(const std::string& input_filename, size_t num_chars) {
+    const size_t k = k_;
+
     if (k <= 1)
         throw std::domain_error("k must be at least 2");
 
-    if (mode == CANONICAL && (k % 2) == 0)
+    if (mode_ == CANONICAL && (k % 2) == 0)
         throw std::domain_error("Primary graphs only supported for odd k");
 
     sshash::build_configuration build_config;
@@ -198,7 +267,7 @@ DBGSSHash::DBGSSHash(const std::string& input_filename, size_t k, Mode mode, siz
 
     build_config.verbose = common::get_verbose();
     build_config.num_threads = get_num_threads();
-    build_config.canonical = mode != BASIC;
+    build_config.canonical = mode_ != BASIC;
 
     // silence sshash construction messages when not verbose
     std::ios orig_state(nullptr);
@@ -317,10 +386,16 @@ void DBGSSHash::map_to_nodes(std::string_view sequence,
                              const std::function<bool()>& terminate) const {
     if (mode_ == BASIC) {
         map_to_nodes_sequentially(sequence, callback, terminate);
-    } else {
-        map_to_nodes_with_rc<true>(
-                sequence, [&](node_index node, bool) { callback(node); }, terminate);
+        return;
     }
+
+    map_to_nodes_with_filter(
+            bloom_filter_, sequence,
+            [&](std::string_view seq, const auto& call, const auto& stop) {
+                map_to_nodes_with_rc<true>(
+                        seq, [&](node_index node, bool) { call(node); }, stop);
+            },
+            callback, terminate);
 }
 
 DBGSSHash::node_index DBGSSHash::reverse_complement(node_index node) const {
@@ -342,6 +417,10 @@ DBGSSHash::node_index DBGSSHash::reverse_complement(node_index node) const {
     return str_kmer != rc_str_kmer ? node + dict_size() : node;
 }
 
+void DBGSSHash::update_extensions() {
+    bloom_filter_ = get_extension_threadsafe<NodeBloomFilter>();
+}
+
 uint64_t DBGSSHash::num_nodes() const {
     return mode_ != CANONICAL ? dict_size() : dict_size() * 2;
 }
@@ -349,17 +428,22 @@ uint64_t DBGSSHash::num_nodes() const {
 void DBGSSHash::map_to_nodes_sequentially(std::string_view sequence,
                                           const std::function<void(node_index)>& callback,
                                           const std::function<bool()>& terminate) const {
-    if (mode_ != BASIC) {
-        map_to_nodes_with_rc<true>(
-                sequence,
-                [&](node_index n, bool revcompl) {
-                    callback(n && revcompl ? reverse_complement(n) : n);
-                },
-                terminate);
-    } else {
-        map_to_nodes_with_rc<false>(
-                sequence, [&](node_index node, bool) { callback(node); }, terminate);
-    }
+    map_to_nodes_with_filter(
+            bloom_filter_, sequence,
+            [&](std::string_view seq, const auto& call, const auto& stop) {
+                if (mode_ != BASIC) {
+                    map_to_nodes_with_rc<true>(
+                            seq,
+                            [&](node_index n, bool revcompl) {
+                                call(n && revcompl ? reverse_complement(n) : n);
+                            },
+                            stop);
+                } else {
+                    map_to_nodes_with_rc<false>(
+                            seq, [&](node_index node, bool) { call(node); }, stop);
+                }
+            },
+            callback, terminate);
 }
 
 DBGSSHash::node_index DBGSSHash::traverse(node_index node, char next_char) const {
@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <variant>
+#include <vector>
+#include <functional>
 
 #include <dictionary.hpp>
 #include <sdsl/uint256_t.hpp>
@@ -12,6 +14,8 @@
 
 namespace mtg::graph {
 
+class NodeBloomFilter;
+
 class DBGSSHash : public DeBruijnGraph {
   public:
     using KmerInt64 = uint64_t;
@@ -36,6 +40,31 @@ class DBGSSHash : public DeBruijnGraph {
               Mode mode = BASIC,
               size_t num_chars = 0);
 
+    typedef std::function<void(std::string_view)> CallSequence;
+
+    // Build from all sequences passed to the callback by |generate_sequences|.
+    // The sequences are spooled to a temporary file in |tmp_dir|, which is then
+    // passed to the SSHash builder. As with the builder, each k-mer must occur
+    // in the sequences at most once, e.g., they must be unitigs or contigs.
+    // Use the constructor from a DeBruijnGraph to index overlapping reads.
+    // If |num_chars| is 0, the total length of the sequences is used.
+    DBGSSHash(const std::function<void(const CallSequence&)>& generate_sequences,
+              size_t k,
+              Mode mode = BASIC,
+              size_t num_chars = 0,
+              const std::string& tmp_dir = "");
+
+    // Build from the unitigs of |source|, with the same k and mode
+    DBGSSHash(const DeBruijnGraph& source,
+              size_t num_threads,
+              const std::string& tmp_dir = "");
+
+    // Map every node of |source| to the node of this graph with the same
+    // k-mer (npos if there is none). The result is indexed by the nodes of
+    // |source| and can be used to reorder the rows of its annotation.
+    std::vector<node_index> map_nodes_from(const DeBruijnGraph& source,
+                                           size_t num_threads = 1) const;
+
     // SequenceGraph overrides
     void add_sequence(
             std::string_view sequence,
@@ -132,6 +161,8 @@ class DBGSSHash : public DeBruijnGraph {
     adjacent_incoming_nodes_with_rc(node_index node,
                                     const std::function<void(node_index, bool)>& callback) const;
 
+  protected:
+    void update_extensions() override;
 
   private:
     static const std::string alphabet_;
@@ -141,9 +172,13 @@ class DBGSSHash : public DeBruijnGraph {
     Mode mode_;
     bit_vector_smart succ_is_next_;
     bit_vector_smart pred_is_prev_;
+    // cached pointer to the NodeBloomFilter extension, if any
+    const NodeBloomFilter *bloom_filter_ = nullptr;
 
     size_t dict_size() const;
 
+    void build(const std::string& input_filename, size_t num_chars);
+
     char get_last_char(node_index node) const;
     char get_first_char(node_index node) const;
 };
@@ -5,6 +5,7 @@
 #include <cstdio>
 
 #include <algorithm>
+#include <exception>
 #include <optional>
 #include <stack>
 #include <string>
@@ -23,6 +24,7 @@
 #include "common/vectors/bit_vector_dyn.hpp"
 #include "common/vectors/bit_vector_adaptive.hpp"
 #include "boss_construct.hpp"
+#include "boss_fused_layout.hpp"
 
 
 namespace mtg {
@@ -46,6 +48,7 @@ const size_t MAX_ITER_WAVELET_TREE_FAST = 1000;
 const size_t MAX_ITER_WAVELET_TREE_DYN = 6;
 const size_t MAX_ITER_WAVELET_TREE_STAT = 20;
 const size_t MAX_ITER_WAVELET_TREE_SMALL = 1;
+const size_t MAX_ITER_WAVELET_TREE_FUSED = 32;
 
 static const uint64_t kBlockSize = 9'999'872;
 static_assert(!(kBlockSize & 0xFF));
@@ -230,7 +233,7 @@ bool BOSS::operator==(const BOSS &other) const {
     return i == W_->size() && j == other.W_->size();
 }
 
-void BOSS::serialize(std::ofstream &outstream) const {
+void BOSS::serialize(std::ofstream &outstream, std::streampos *last_offset) const {
     if (!outstream.good())
         throw std::ofstream::failure("Error: Can't write to file");
 
@@ -243,11 +246,15 @@ void BOSS::serialize(std::ofstream &outstream) const {
     W_->serialize(outstream);
 
     // write last array
+    if (last_offset)
+        *last_offset = outstream.tellp();
+
     last_->serialize(outstream);
     outstream.flush();
 }
 
-void BOSS::serialize(Chunk&& chunk, std::ofstream &out, State state) {
+void BOSS::serialize(Chunk&& chunk, std::ofstream &out, State state,
+                     std::streampos *last_offset) {
     if (!out.good())
         throw std::ofstream::failure("Error: Can't write to file");
 
@@ -264,6 +271,8 @@ void BOSS::serialize(Chunk&& chunk, std::ofstream &out, State state) {
         W.serialize(out); }
 
 #define SERIALIZE_LAST(bv_type) \
+        if (last_offset) \
+            *last_offset = out.tellp(); \
         bv_type(to_vector(chunk.last_)).serialize(out); \
         chunk.last_.close(true);
 
@@ -290,12 +299,23 @@ void BOSS::serialize(Chunk&& chunk, std::ofstream &out, State state) {
             SERIALIZE_W(wavelet_tree_small);
             SERIALIZE_LAST(bit_vector_small);
             break;
+        case State::FUSED: {
+            FusedLayout layout(chunk.get_W_width(), to_vector(chunk.W_),
+                               to_vector(chunk.last_));
+            chunk.W_.close(true);
+            chunk.last_.close(true);
+            // last is stored in the layout, so nothing is written for it
+            layout.serialize(out);
+            if (last_offset)
+                *last_offset = out.tellp();
+            break;
+        }
     }
 
     out.flush();
 }
 
-bool BOSS::load(std::ifstream &instream) {
+bool BOSS::load(std::istream &instream, std::istream *last_instream) {
     // if not specified in the file, the default for loading is dynamic
     state = State::DYN;
 
@@ -330,20 +350,57 @@ bool BOSS::load(std::ifstream &instream) {
                 W_ = new wavelet_tree_small(bits_per_char_W_);
                 last_ = new bit_vector_small();
                 break;
+            case State::FUSED: {
+                auto layout = std::make_shared<FusedLayout>();
+                W_ = new wavelet_tree_fused(layout);
+                last_ = new bit_vector_fused(layout);
+                break;
+            }
         }
-        if (!W_->load(instream)) {
+
+        // exceptions must not escape the parallel region
+        std::exception_ptr exception;
+        auto load_vector = [&exception](auto *vector, std::istream &in) {
+            try {
+                return vector->load(in);
+            } catch (...) {
+                #pragma omp critical
+                exception = std::current_exception();
+                return false;
+            }
+        };
+
+        bool W_loaded = false;
+        bool last_loaded = false;
+        if (last_instream) {
+            #pragma omp parallel sections num_threads(2)
+            {
+                #pragma omp section
+                W_loaded = load_vector(W_, instream);
+                #pragma omp section
+                last_loaded = load_vector(last_, *last_instream);
+            }
+        } else {
+            W_loaded = load_vector(W_, instream);
+            last_loaded = W_loaded && load_vector(last_, instream);
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+
+        if (!W_loaded) {
             std::cerr << "ERROR: failed to load W vector" << std::endl;
             return false;
         }
 
-        if (!last_->load(instream)) {
+        if (!last_loaded) {
             std::cerr << "ERROR: failed to load L vector" << std::endl;
             return false;
         }
 
         recompute_NF();
 
-        return instream.good();
+        return instream.good() && (!last_instream || last_instream->good());
 
     } catch (const std::bad_alloc &exception) {
         std::cerr << "ERROR: Not enough memory to load the BOSS table." << std::endl;
@@ -359,7 +416,7 @@ void BOSS::serialize_suffix_ranges(std::ofstream &outstream) const {
     indexed_suffix_ranges_.serialize(outstream);
 }
 
-bool BOSS::load_suffix_ranges(std::ifstream &instream) {
+bool BOSS::load_suffix_ranges(std::istream &instream) {
     // load node suffix range index if exists
     try {
         indexed_suffix_length_ = load_number(instream);
@@ -434,6 +491,9 @@ edge_index BOSS::pred_W(edge_index i, TAlphabet c_first, TAlphabet c_second) con
         case FAST:
             max_iter = MAX_ITER_WAVELET_TREE_FAST;
             break;
+        case FUSED:
+            max_iter = MAX_ITER_WAVELET_TREE_FUSED;
+            break;
     }
 
     edge_index end = i - std::min(i, max_iter);
@@ -492,6 +552,9 @@ BOSS::succ_W(edge_index i, TAlphabet c_first, TAlphabet c_second) const {
         case FAST:
             max_iter = MAX_ITER_WAVELET_TREE_FAST;
             break;
+        case FUSED:
+            max_iter = MAX_ITER_WAVELET_TREE_FUSED;
+            break;
     }
 
     edge_index end = i + std::min(W_->size() - i, max_iter);
@@ -1122,6 +1185,17 @@ void BOSS::switch_state(State new_state) {
             convert<wavelet_tree_dyn, bit_vector_dyn>(&W_, &last_);
             break;
         }
+        case State::FUSED: {
+            common::logger->trace("Building the fused layout of W and last");
+            auto layout = std::make_shared<FusedLayout>(bits_per_char_W_,
+                                                        W_->to_vector(),
+                                                        last_->to_vector());
+            delete W_;
+            delete last_;
+            W_ = new wavelet_tree_fused(layout);
+            last_ = new bit_vector_fused(layout);
+            break;
+        }
     }
     state = new_state;
 }
@@ -68,14 +68,20 @@ class BOSS {
     uint64_t num_nodes() const;
     uint64_t num_edges() const;
 
-    bool load(std::ifstream &instream);
-    void serialize(std::ofstream &outstream) const;
+    /**
+     * Load the BOSS table. If |last_instream| is passed, it must be positioned
+     * at the serialized last array, which is then loaded concurrently with W.
+     * In that case, |instream| is left at the end of W.
+     */
+    bool load(std::istream &instream, std::istream *last_instream = nullptr);
+    // If |last_offset| is passed, the position of the last array is written to it
+    void serialize(std::ofstream &outstream, std::streampos *last_offset = nullptr) const;
 
     /**
      * Load the index of node ranges constructed with index_suffix_ranges()
      * to speed up the search in the BOSS table.
      */
-    bool load_suffix_ranges(std::ifstream &instream);
+    bool load_suffix_ranges(std::istream &instream);
     void serialize_suffix_ranges(std::ofstream &outstream) const;
     // Estimate the size of the compressed index in bits
     uint64_t get_suffix_ranges_index_size() const {
@@ -328,8 +334,15 @@ class BOSS {
      *      Representation:
      *          last -- bit_vector_dyn
      *             W -- wavelet_tree_dyn
+     *
+     * FUSED: interleaves W, last, and their ranks in cache lines, so that
+     *        access and rank queries touch a single cache line.
+     *        Supports alphabets of W with up to 16 characters only.
+     *      Representation:
+     *          last -- bit_vector_fused
+     *             W -- wavelet_tree_fused
      */
-    enum State { SMALL = 1, DYN, STAT, FAST };
+    enum State { SMALL = 1, DYN, STAT, FAST, FUSED };
 
     State get_state() const { return state; }
     void switch_state(State state);
@@ -622,7 +635,9 @@ class BOSS {
     void initialize(Chunk *chunk);
     // Initialize a BOSS table from Chunk and serialize without loading to RAM.
     // FYI: Note that suffix ranges will not be indexed.
-    static void serialize(Chunk&& chunk, std::ofstream &outstream, State state = State::STAT);
+    static void serialize(Chunk&& chunk, std::ofstream &outstream,
+                          State state = State::STAT,
+                          std::streampos *last_offset = nullptr);
 };
 
 std::ostream& operator<<(std::ostream &os, const BOSS &graph);
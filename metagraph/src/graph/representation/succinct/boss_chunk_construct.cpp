@@ -1029,6 +1029,12 @@ class BOSSChunkConstructor : public IBOSSChunkConstructor {
         kmer_collector_.add_sequences(std::move(sequences));
     }
 
+    void add_packed_kmers(size_t length,
+                          std::vector<uint64_t>&& packed,
+                          std::vector<uint64_t>&& counts) {
+        kmer_collector_.add_packed_kmers(length, std::move(packed), std::move(counts));
+    }
+
     BOSS::Chunk build_chunk() {
         BOSS::Chunk result;
 
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <vector>
 
 #include "kmer/kmer_collector_config.hpp"
 #include "graph/representation/base/dbg_construct.hpp"
@@ -30,6 +31,12 @@ class IBOSSChunkConstructor : public IGraphChunkConstructor<BOSS::Chunk> {
                const std::filesystem::path &swap_dir = "/tmp/",
                size_t disk_cap_bytes = 1e9);
 
+    // Add k-mers packed with two bits per character, as read from KMC
+    // databases by seq_io::read_kmers_packed
+    virtual void add_packed_kmers(size_t length,
+                                  std::vector<uint64_t>&& packed,
+                                  std::vector<uint64_t>&& counts) = 0;
+
     virtual uint64_t get_k() const = 0;
 };
 
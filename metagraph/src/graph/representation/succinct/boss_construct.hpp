@@ -28,6 +28,12 @@ class BOSSConstructor : public IGraphConstructor<BOSS> {
         constructor_->add_sequences(std::move(sequences));
     }
 
+    void add_packed_kmers(size_t length,
+                          std::vector<uint64_t>&& packed,
+                          std::vector<uint64_t>&& counts) {
+        constructor_->add_packed_kmers(length, std::move(packed), std::move(counts));
+    }
+
     void build_graph(BOSS *graph) {
         auto chunk = constructor_->build_chunk();
         // initialize graph from the chunk built
@@ -0,0 +1,355 @@
+#include "boss_fused_layout.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include <sdsl/bits.hpp>
+
+#include "common/serialization.hpp"
+#include "common/utils/simd_utils.hpp"
+
+
+namespace mtg {
+namespace graph {
+namespace boss {
+
+// a bit at the lowest position of every 4-bit symbol in a word
+static constexpr uint64_t kLowNibbleBits = 0x1111111111111111;
+// the number of lines scanned by next() before falling back to select
+static constexpr uint64_t kMaxScanLines = 4;
+
+
+FusedLayout::FusedLayout(uint8_t logsigma,
+                         const sdsl::int_vector<> &W,
+                         const sdsl::bit_vector &last)
+      : size_(W.size()), logsigma_(logsigma) {
+    if (logsigma > kMaxLogSigma)
+        throw std::runtime_error("The fused BOSS layout supports alphabets of W "
+                                 "with up to 16 characters");
+
+    if (W.size() != last.size())
+        throw std::runtime_error("The arrays W and last have different sizes");
+
+    const uint64_t num_lines = (size_ + kLineSize - 1) / kLineSize;
+    lines_.assign(num_lines, Line {});
+    superblock_ranks_ = sdsl::int_vector<64>(
+        (num_lines + kLinesPerSuperblock - 1) / kLinesPerSuperblock * kNumCounters, 0
+    );
+    counts_.assign(kNumCounters, 0);
+
+    std::vector<std::vector<uint64_t>> samples(kNumCounters);
+
+    for (uint64_t l = 0; l < num_lines; ++l) {
+        Line &line = lines_[l];
+        const uint64_t superblock = l / kLinesPerSuperblock * kNumCounters;
+
+        for (size_t c = 0; c < kNumCounters; ++c) {
+            if (l % kLinesPerSuperblock == 0)
+                superblock_ranks_[superblock + c] = counts_[c];
+
+            line.ranks[c] = counts_[c] - superblock_ranks_[superblock + c];
+        }
+
+        const uint64_t begin = l * kLineSize;
+        const uint64_t end = std::min(begin + kLineSize, size_);
+        for (uint64_t i = begin; i < end; ++i) {
+            const uint64_t j = i - begin;
+            const TAlphabet c = W[i];
+            assert(c < (1u << kMaxLogSigma));
+
+            line.W[j / 16] |= c << (j % 16 * 4);
+            if (counts_[c]++ % kSelectSampleRate == 0)
+                samples[c].push_back(l);
+
+            if (last[i]) {
+                line.last |= 1u << j;
+                if (counts_[kLast]++ % kSelectSampleRate == 0)
+                    samples[kLast].push_back(l);
+            }
+        }
+    }
+
+    select_samples_.resize(kNumCounters);
+    for (size_t c = 0; c < kNumCounters; ++c) {
+        select_samples_[c] = sdsl::int_vector<64>(samples[c].size());
+        std::copy(samples[c].begin(), samples[c].end(), select_samples_[c].begin());
+    }
+}
+
+uint32_t FusedLayout::match(const Line &line, size_t c) {
+    if (c == kLast)
+        return line.last;
+
+    assert(c < (1u << kMaxLogSigma));
+
+    uint32_t mask = 0;
+    for (size_t w = 0; w < 2; ++w) {
+        // all four bits of the matching symbols become zero
+        uint64_t x = line.W[w] ^ (c * kLowNibbleBits);
+        x = ~(x | x >> 1 | x >> 2 | x >> 3) & kLowNibbleBits;
+#if __BMI2__
+        x = _pext_u64(x, kLowNibbleBits);
+#else
+        // gather the lowest bit of every nibble into the lowest 16 bits
+        x = (x | x >> 3) & 0x0303030303030303;
+        x = (x | x >> 6) & 0x000F000F000F000F;
+        x = (x | x >> 12) & 0x000000FF000000FF;
+        x = (x | x >> 24) & 0xFFFF;
+#endif
+        mask |= x << (w * 16);
+    }
+    return mask;
+}
+
+uint64_t FusedLayout::rank(size_t c, uint64_t i) const {
+    if (!size_)
+        return 0;
+
+    i = std::min(i, size_ - 1);
+    const uint64_t l = i / kLineSize;
+    const uint64_t mask = (2llu << (i % kLineSize)) - 1;
+    return rank_before(l, c) + sdsl::bits::cnt(match(lines_[l], c) & mask);
+}
+
+uint64_t FusedLayout::select(size_t c, uint64_t r) const {
+    assert(r >= 1);
+    assert(r <= counts_[c]);
+
+    // the sampled lines bound the line with the r-th occurrence
+    const auto &samples = select_samples_[c];
+    const uint64_t s = (r - 1) / kSelectSampleRate;
+    uint64_t lo = samples[s];
+    uint64_t hi = s + 1 < samples.size() ? samples[s + 1] : lines_.size() - 1;
+
+    // find the last line with fewer than r occurrences before it
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        if (rank_before(mid, c) < r) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo * kLineSize + sdsl::bits::sel(match(lines_[lo], c),
+                                            r - rank_before(lo, c));
+}
+
+uint64_t FusedLayout::select0_last(uint64_t r) const {
+    assert(r >= 1);
+    assert(r <= size_ - counts_[kLast]);
+
+    auto zeros_before = [&](uint64_t l) { return l * kLineSize - rank_before(l, kLast); };
+
+    uint64_t lo = 0;
+    uint64_t hi = lines_.size() - 1;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        if (zeros_before(mid) < r) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo * kLineSize + sdsl::bits::sel(~static_cast<uint64_t>(lines_[lo].last),
+                                            r - zeros_before(lo));
+}
+
+uint64_t FusedLayout::next(size_t c, uint64_t i) const {
+    assert(i < size_);
+
+    uint64_t l = i / kLineSize;
+    uint64_t mask = match(lines_[l], c) & (~0llu << (i % kLineSize));
+
+    // the occurrences are usually close, so scan a few lines first
+    for (uint64_t end = std::min(l + kMaxScanLines, lines_.size()); !mask && ++l < end; ) {
+        mask = match(lines_[l], c);
+    }
+
+    if (mask) {
+        // the padding in the last line may match
+        return std::min(l * kLineSize + __builtin_ctzll(mask), size_);
+    }
+
+    if (l >= lines_.size())
+        return size_;
+
+    uint64_t r = rank_before(l, c);
+    return r < counts_[c] ? select(c, r + 1) : size_;
+}
+
+uint64_t FusedLayout::prev(size_t c, uint64_t i) const {
+    assert(i < size_);
+
+    const uint64_t l = i / kLineSize;
+    const uint64_t mask = match(lines_[l], c) & ((2llu << (i % kLineSize)) - 1);
+    if (mask)
+        return l * kLineSize + 63 - __builtin_clzll(mask);
+
+    uint64_t r = rank_before(l, c);
+    return r ? select(c, r) : size_;
+}
+
+uint64_t FusedLayout::get_last_int(uint64_t i, uint32_t width) const {
+    assert(width <= 64);
+    assert(i + width <= size_);
+
+    uint64_t result = 0;
+    for (uint32_t done = 0; done < width; ) {
+        const uint64_t l = (i + done) / kLineSize;
+        const uint64_t offset = (i + done) % kLineSize;
+        result |= static_cast<uint64_t>(lines_[l].last >> offset) << done;
+        done += kLineSize - offset;
+    }
+    return width < 64 ? result & ((1llu << width) - 1) : result;
+}
+
+sdsl::int_vector<> FusedLayout::get_W_vector() const {
+    sdsl::int_vector<> vector(size_, 0, std::max(logsigma_, uint8_t(1)));
+    for (uint64_t i = 0; i < size_; ++i) {
+        vector[i] = get_W(i);
+    }
+    return vector;
+}
+
+sdsl::bit_vector FusedLayout::get_last_vector() const {
+    sdsl::bit_vector vector(size_, 0);
+    for (uint64_t l = 0; l < lines_.size(); ++l) {
+        const uint64_t begin = l * kLineSize;
+        vector.set_int(begin, lines_[l].last, std::min(kLineSize, size_ - begin));
+    }
+    return vector;
+}
+
+bool FusedLayout::load(std::istream &in) {
+    if (!in.good())
+        return false;
+
+    try {
+        size_ = load_number(in);
+        logsigma_ = load_number(in);
+
+        lines_.resize((size_ + kLineSize - 1) / kLineSize);
+        in.read(reinterpret_cast<char *>(lines_.data()), lines_.size() * sizeof(Line));
+
+        superblock_ranks_.load(in);
+
+        select_samples_.resize(kNumCounters);
+        for (auto &samples : select_samples_) {
+            samples.load(in);
+        }
+
+        counts_ = load_number_vector_raw<uint64_t>(in);
+
+        return in.good() && counts_.size() == kNumCounters;
+
+    } catch (const std::bad_alloc &exception) {
+        std::cerr << "ERROR: Not enough memory to load the fused BOSS layout." << std::endl;
+        return false;
+    } catch (...) {
+        return false;
+    }
+}
+
+void FusedLayout::serialize(std::ostream &out) const {
+    serialize_number(out, size_);
+    serialize_number(out, logsigma_);
+
+    out.write(reinterpret_cast<const char *>(lines_.data()), lines_.size() * sizeof(Line));
+
+    superblock_ranks_.serialize(out);
+
+    assert(select_samples_.size() == kNumCounters || !size_);
+    for (size_t c = 0; c < kNumCounters; ++c) {
+        if (c < select_samples_.size()) {
+            select_samples_[c].serialize(out);
+        } else {
+            sdsl::int_vector<64>().serialize(out);
+        }
+    }
+
+    if (counts_.size() == kNumCounters) {
+        serialize_number_vector_raw(out, counts_);
+    } else {
+        serialize_number_vector_raw(out, std::vector<uint64_t>(kNumCounters, 0));
+    }
+}
+
+
+uint64_t wavelet_tree_fused::rank(TAlphabet c, uint64_t i) const {
+    assert(c < (1llu << logsigma()));
+    return layout_->rank_W(c, i);
+}
+
+uint64_t wavelet_tree_fused::select(TAlphabet c, uint64_t i) const {
+    assert(c < (1llu << logsigma()));
+    return layout_->select_W(c, i);
+}
+
+std::pair<uint64_t, wavelet_tree::TAlphabet>
+wavelet_tree_fused::inverse_select(uint64_t i) const {
+    assert(i < size());
+    TAlphabet c = layout_->get_W(i);
+    return std::make_pair(layout_->rank_W(c, i) - 1, c);
+}
+
+uint64_t wavelet_tree_fused::next(uint64_t i, TAlphabet c) const {
+    assert(i < size());
+    assert(c < (1llu << logsigma()));
+    return layout_->next_W(c, i);
+}
+
+uint64_t wavelet_tree_fused::prev(uint64_t i, TAlphabet c) const {
+    assert(i < size());
+    assert(c < (1llu << logsigma()));
+    return layout_->prev_W(c, i);
+}
+
+
+uint64_t bit_vector_fused::rank1(uint64_t id) const {
+    return layout_->rank_last(id);
+}
+
+uint64_t bit_vector_fused::next1(uint64_t id) const {
+    assert(id < size());
+    return layout_->next_last(id);
+}
+
+uint64_t bit_vector_fused::prev1(uint64_t id) const {
+    assert(id < size());
+    return layout_->prev_last(id);
+}
+
+uint64_t bit_vector_fused::get_int(uint64_t id, uint32_t width) const {
+    return layout_->get_last_int(id, width);
+}
+
+void bit_vector_fused::call_ones_in_range(uint64_t begin, uint64_t end,
+                                          const VoidCall<uint64_t> &callback) const {
+    assert(begin <= end);
+    assert(end <= size());
+
+    for (uint64_t i = begin; i < end; i += 64) {
+        uint64_t word = get_int(i, std::min(uint64_t(64), end - i));
+        while (word) {
+            callback(i + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+void bit_vector_fused::add_to(sdsl::bit_vector *other) const {
+    assert(other);
+    assert(other->size() == size());
+
+    for (uint64_t i = 0; i < size(); i += 64) {
+        const uint32_t width = std::min(uint64_t(64), size() - i);
+        other->set_int(i, other->get_int(i, width) | get_int(i, width), width);
+    }
+}
+
+} // namespace boss
+} // namespace graph
+} // namespace mtg
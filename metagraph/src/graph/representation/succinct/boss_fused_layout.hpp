@@ -0,0 +1,196 @@
+#ifndef __BOSS_FUSED_LAYOUT_HPP__
+#define __BOSS_FUSED_LAYOUT_HPP__
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include <sdsl/int_vector.hpp>
+
+#include "common/vectors/bit_vector.hpp"
+#include "common/vectors/wavelet_tree.hpp"
+
+
+namespace mtg {
+namespace graph {
+namespace boss {
+
+/**
+ * A static layout of the arrays W and last of the BOSS table interleaved in
+ * cache lines. Each 64-byte line stores 32 consecutive edges: their W symbols,
+ * their last bits, and the ranks of all symbols and of the set last bits
+ * before the line, relative to the superblock of 2^16 edges it belongs to.
+ * Thus, access and rank queries touch a single cache line, and select queries
+ * start from sampled lines and usually touch a few neighboring ones.
+ *
+ * Only alphabets of W with up to 16 symbols (logsigma <= 4) are supported.
+ */
+class FusedLayout {
+  public:
+    typedef wavelet_tree::TAlphabet TAlphabet;
+
+    static constexpr uint8_t kMaxLogSigma = 4;
+
+    FusedLayout() {}
+    FusedLayout(uint8_t logsigma,
+                const sdsl::int_vector<> &W,
+                const sdsl::bit_vector &last);
+
+    uint64_t size() const { return size_; }
+    uint8_t logsigma() const { return logsigma_; }
+
+    TAlphabet get_W(uint64_t i) const {
+        assert(i < size_);
+        const Line &line = lines_[i / kLineSize];
+        const uint64_t j = i % kLineSize;
+        return (line.W[j / 16] >> (j % 16 * 4)) & 0xF;
+    }
+    bool get_last(uint64_t i) const {
+        assert(i < size_);
+        return (lines_[i / kLineSize].last >> (i % kLineSize)) & 1;
+    }
+
+    // The number of occurrences of |c| in W[0..i]
+    uint64_t rank_W(TAlphabet c, uint64_t i) const { return rank(c, i); }
+    // The position of the |r|-th occurrence of |c| in W, starting from 1
+    uint64_t select_W(TAlphabet c, uint64_t r) const { return select(c, r); }
+    uint64_t count_W(TAlphabet c) const { return counts_[c]; }
+    // The first position of |c| in W[i..], or size() if there is none
+    uint64_t next_W(TAlphabet c, uint64_t i) const { return next(c, i); }
+    // The last position of |c| in W[..i], or size() if there is none
+    uint64_t prev_W(TAlphabet c, uint64_t i) const { return prev(c, i); }
+
+    // The number of set bits in last[0..i]
+    uint64_t rank_last(uint64_t i) const { return rank(kLast, i); }
+    // The position of the |r|-th set bit in last, starting from 1
+    uint64_t select_last(uint64_t r) const { return select(kLast, r); }
+    uint64_t select0_last(uint64_t r) const;
+    uint64_t num_set_bits_last() const { return counts_[kLast]; }
+    uint64_t next_last(uint64_t i) const { return next(kLast, i); }
+    uint64_t prev_last(uint64_t i) const { return prev(kLast, i); }
+    // The bits last[i..i+width) packed in an integer
+    uint64_t get_last_int(uint64_t i, uint32_t width) const;
+
+    sdsl::int_vector<> get_W_vector() const;
+    sdsl::bit_vector get_last_vector() const;
+
+    bool load(std::istream &in);
+    void serialize(std::ostream &out) const;
+
+  private:
+    // symbols 0..15 are the characters of W, 16 marks the set bits in last
+    static constexpr size_t kLast = 16;
+    static constexpr size_t kNumCounters = kLast + 1;
+
+    static constexpr uint64_t kLineSize = 32;
+    static constexpr uint64_t kLinesPerSuperblock = (1 << 16) / kLineSize;
+    static constexpr uint64_t kSelectSampleRate = 128;
+
+    struct alignas(64) Line {
+        uint64_t W[2];                    // 32 symbols, 4 bits each
+        uint32_t last;                    // 32 bits of last
+        uint16_t ranks[kNumCounters];     // ranks relative to the superblock
+    };
+    static_assert(sizeof(Line) == 64);
+
+    // A mask with the positions of |c| in |line| (of set bits, for c = kLast)
+    static uint32_t match(const Line &line, size_t c);
+
+    uint64_t rank_before(uint64_t line, size_t c) const {
+        return superblock_ranks_[line / kLinesPerSuperblock * kNumCounters + c]
+                + lines_[line].ranks[c];
+    }
+
+    uint64_t rank(size_t c, uint64_t i) const;
+    uint64_t select(size_t c, uint64_t r) const;
+    uint64_t next(size_t c, uint64_t i) const;
+    uint64_t prev(size_t c, uint64_t i) const;
+
+    uint64_t size_ = 0;
+    uint8_t logsigma_ = 0;
+    std::vector<Line> lines_;
+    sdsl::int_vector<64> superblock_ranks_;
+    // the lines with every kSelectSampleRate-th occurrence of each symbol
+    std::vector<sdsl::int_vector<64>> select_samples_;
+    std::vector<uint64_t> counts_;
+};
+
+
+/**
+ * The view of W stored in the fused layout.
+ * It shares the layout with the view of last (bit_vector_fused).
+ */
+class wavelet_tree_fused : public wavelet_tree {
+  public:
+    explicit wavelet_tree_fused(std::shared_ptr<FusedLayout> layout)
+      : layout_(std::move(layout)) {}
+
+    uint64_t rank(TAlphabet c, uint64_t i) const override;
+    uint64_t select(TAlphabet c, uint64_t i) const override;
+    TAlphabet operator[](uint64_t i) const override { return layout_->get_W(i); }
+    std::pair<uint64_t, TAlphabet> inverse_select(uint64_t i) const override;
+
+    uint64_t next(uint64_t i, TAlphabet c) const override;
+    uint64_t prev(uint64_t i, TAlphabet c) const override;
+
+    uint64_t size() const override { return layout_->size(); }
+    uint8_t logsigma() const override { return layout_->logsigma(); }
+    uint64_t count(TAlphabet c) const override { return layout_->count_W(c); }
+
+    // The layout is serialized with W, and the view of last stores nothing
+    bool load(std::istream &in) override { return layout_->load(in); }
+    void serialize(std::ostream &out) const override { layout_->serialize(out); }
+
+    void clear() override { *layout_ = FusedLayout(); }
+
+    sdsl::int_vector<> to_vector() const override { return layout_->get_W_vector(); }
+
+  private:
+    std::shared_ptr<FusedLayout> layout_;
+};
+
+
+/**
+ * The view of last stored in the fused layout.
+ */
+class bit_vector_fused : public bit_vector {
+  public:
+    explicit bit_vector_fused(std::shared_ptr<FusedLayout> layout)
+      : layout_(std::move(layout)) {}
+
+    std::unique_ptr<bit_vector> copy() const override {
+        return std::make_unique<bit_vector_fused>(*this);
+    }
+
+    uint64_t rank1(uint64_t id) const override;
+    uint64_t select0(uint64_t id) const override { return layout_->select0_last(id); }
+    uint64_t select1(uint64_t id) const override { return layout_->select_last(id); }
+
+    uint64_t next1(uint64_t id) const override;
+    uint64_t prev1(uint64_t id) const override;
+
+    bool operator[](uint64_t id) const override { return layout_->get_last(id); }
+    uint64_t get_int(uint64_t id, uint32_t width) const override;
+
+    bool load(std::istream &) override { return true; }
+    void serialize(std::ostream &) const override {}
+
+    uint64_t size() const override { return layout_->size(); }
+    uint64_t num_set_bits() const override { return layout_->num_set_bits_last(); }
+
+    void call_ones_in_range(uint64_t begin, uint64_t end,
+                            const VoidCall<uint64_t> &callback) const override;
+
+    void add_to(sdsl::bit_vector *other) const override;
+
+    sdsl::bit_vector to_vector() const override { return layout_->get_last_vector(); }
+
+  private:
+    std::shared_ptr<FusedLayout> layout_;
+};
+
+} // namespace boss
+} // namespace graph
+} // namespace mtg
+
+#endif // __BOSS_FUSED_LAYOUT_HPP__
@@ -6,6 +6,7 @@
 #include <string>
 #include <filesystem>
 
+#include "common/block_table.hpp"
 #include "common/seq_tools/reverse_complement.hpp"
 #include "common/serialization.hpp"
 #include "common/logger.hpp"
@@ -692,15 +693,41 @@ bool DBGSuccinct::load_without_mask(const std::string &filename) {
     valid_edges_.reset();
 
     {
-        std::unique_ptr<std::ifstream> in
-            = utils::open_ifstream(utils::make_suffix(filename, kExtension));
+        const auto fname = utils::make_suffix(filename, kExtension);
+
+        // If the file ends with a table of blocks, the blocks are read ahead
+        // in parallel and verified against their checksums. The last array is
+        // then loaded concurrently with W from a second stream, which continues
+        // to the mode and the index of suffix ranges stored right after it.
+        common::BlockTable block_table;
+        const bool with_blocks = block_table.load(fname)
+                                    && block_table.sections().size() == 1;
+        const size_t num_threads = get_num_threads();
+        ThreadPool thread_pool(with_blocks ? num_threads : 0);
+
+        std::unique_ptr<std::istream> in;
+        std::unique_ptr<std::istream> last_in;
+        if (with_blocks) {
+            const uint64_t last_offset = block_table.sections()[0];
+            in = std::make_unique<common::BlockIfstream>(
+                fname, block_table, 0, last_offset, thread_pool, num_threads
+            );
+            last_in = std::make_unique<common::BlockIfstream>(
+                fname, block_table, last_offset, block_table.data_size(),
+                thread_pool, num_threads
+            );
+        } else {
+            in = utils::open_ifstream(fname);
+        }
 
-        if (!boss_graph_->load(*in))
+        if (!boss_graph_->load(*in, last_in.get()))
             return false;
 
-        mode_ = static_cast<Mode>(load_number(*in));
+        std::istream &rest = last_in ? *last_in : *in;
+
+        mode_ = static_cast<Mode>(load_number(rest));
 
-        if (!boss_graph_->load_suffix_ranges(*in))
+        if (!boss_graph_->load_suffix_ranges(rest))
             logger->warn("No index for node ranges could be loaded");
     }
 
@@ -723,7 +750,8 @@ bool DBGSuccinct::load(const std::string &filename) {
             valid_edges_.reset(new bit_vector_small());
             break;
         }
-        case BOSS::State::FAST: {
+        case BOSS::State::FAST:
+        case BOSS::State::FUSED: {
             valid_edges_.reset(new bit_vector_stat());
             break;
         }
@@ -790,10 +818,13 @@ void DBGSuccinct::serialize(const std::string &filename) const {
     {
         const std::string out_filename = prefix + kExtension;
         std::ofstream out = utils::open_new_ofstream(out_filename);
-        boss_graph_->serialize(out);
+        common::BlockTableWriter block_table(out);
+        std::streampos last_offset;
+        boss_graph_->serialize(out, &last_offset);
         serialize_number(out, static_cast<int>(mode_));
 
         boss_graph_->serialize_suffix_ranges(out);
+        block_table.append_table({ static_cast<uint64_t>(last_offset) });
 
         if (!out.good())
             throw std::ios_base::failure("Can't write to file " + out_filename);
@@ -802,7 +833,8 @@ void DBGSuccinct::serialize(const std::string &filename) const {
     auto serialize_valid_edges = [&](auto &&valid_edges) {
         assert((boss_graph_->get_state() == BOSS::State::STAT
                     && dynamic_cast<const bit_vector_small*>(valid_edges.get()))
-            || (boss_graph_->get_state() == BOSS::State::FAST
+            || ((boss_graph_->get_state() == BOSS::State::FAST
+                        || boss_graph_->get_state() == BOSS::State::FUSED)
                     && dynamic_cast<const bit_vector_stat*>(valid_edges.get()))
             || (boss_graph_->get_state() == BOSS::State::DYN
                     && dynamic_cast<const bit_vector_dyn*>(valid_edges.get()))
@@ -839,9 +871,14 @@ void DBGSuccinct::serialize(boss::BOSS::Chunk&& chunk,
 
     const std::string &fname = prefix + kExtension;
     std::ofstream out = utils::open_new_ofstream(fname);
-    boss::BOSS::serialize(std::move(chunk), out, state);
+    common::BlockTableWriter block_table(out);
+    std::streampos last_offset;
+    boss::BOSS::serialize(std::move(chunk), out, state, &last_offset);
     serialize_number(out, static_cast<int>(mode));
-    serialize_number(out, 0); // suffix ranges are not indexed
+    // suffix ranges are not indexed
+    serialize_number(out, 0);
+    sdsl::sd_vector<>().serialize(out);
+    block_table.append_table({ static_cast<uint64_t>(last_offset) });
     if (!out.good())
         throw std::ios_base::failure("Can't write to file " + fname);
 }
@@ -858,7 +895,8 @@ void DBGSuccinct::switch_state(BOSS::State new_state) {
                 );
                 break;
             }
-            case BOSS::State::FAST: {
+            case BOSS::State::FAST:
+            case BOSS::State::FUSED: {
                 valid_edges_ = std::make_unique<bit_vector_stat>(
                     valid_edges_->convert_to<bit_vector_stat>()
                 );
@@ -889,6 +927,9 @@ BOSS::State DBGSuccinct::get_state() const {
     assert(!valid_edges_.get()
                 || boss_graph_->get_state() != BOSS::State::FAST
                 || dynamic_cast<const bit_vector_stat*>(valid_edges_.get()));
+    assert(!valid_edges_.get()
+                || boss_graph_->get_state() != BOSS::State::FUSED
+                || dynamic_cast<const bit_vector_stat*>(valid_edges_.get()));
     assert(!valid_edges_.get()
                 || boss_graph_->get_state() != BOSS::State::DYN
                 || dynamic_cast<const bit_vector_dyn*>(valid_edges_.get()));
@@ -910,6 +951,7 @@ std::unique_ptr<bit_vector> DBGSuccinct::generate_valid_kmer_mask(size_t num_thr
         case BOSS::State::STAT:
             return std::make_unique<bit_vector_small>(std::move(vector_mask));
         case BOSS::State::FAST:
+        case BOSS::State::FUSED:
             return std::make_unique<bit_vector_stat>(std::move(vector_mask));
         case BOSS::State::DYN:
             return std::make_unique<bit_vector_dyn>(std::move(vector_mask));
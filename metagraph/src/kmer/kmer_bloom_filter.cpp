@@ -17,6 +17,9 @@ namespace kmer {
 typedef KmerExtractorBOSS KmerDef;
 typedef KmerDef::TAlphabet TAlphabet;
 
+// the number of k-mer hashes checked in the Bloom filter at once
+constexpr size_t kCheckBatchSize = 1024;
+
 
 template <class KmerBF, class Callback>
 inline void call_kmers(const KmerBF &kmer_bloom,
@@ -171,14 +174,30 @@ sdsl::bit_vector KmerBloomFilter<KmerHasher>
     if (sequence.size() < k_)
         return sdsl::bit_vector();
 
-    // aggregate hashes, then batch check
-    size_t i = 0;
-    AlignedVector<uint64_t> hashes(sequence.size() - k_ + 1);
-    call_kmers(*this, sequence, [&](auto hash) { hashes[i++] = hash; });
+    sdsl::bit_vector presence(sequence.size() - k_ + 1, false);
+
+    // Check the hashes in small batches while they are still in cache,
+    // interleaving the hash computation with the probes
+    size_t num_checked = 0;
+    AlignedVector<uint64_t> hashes;
+    hashes.reserve(std::min(kCheckBatchSize, presence.size()));
+    auto check_batch = [&]() {
+        filter_.check(hashes.data(), hashes.data() + hashes.size(),
+                      [&](size_t i) { presence[num_checked + i] = true; });
+        num_checked += hashes.size();
+        hashes.clear();
+    };
+
+    call_kmers(*this, sequence, [&](auto hash) {
+        hashes.push_back(hash);
+        if (hashes.size() == kCheckBatchSize)
+            check_batch();
+    });
+    check_batch();
 
-    assert(i == hashes.size());
+    assert(num_checked == presence.size());
 
-    return filter_.check(hashes.data(), hashes.data() + hashes.size());
+    return presence;
 }
 
 template <class KmerHasher>
@@ -126,6 +126,94 @@ void count_kmers(std::function<void(CallStringCount)> generate_reads,
     }
 }
 
+template <typename KMER, class KmerExtractor, class Container>
+void extract_packed_kmers(std::shared_ptr<const std::vector<uint64_t>> packed,
+                          std::shared_ptr<const std::vector<uint64_t>> counts,
+                          size_t length,
+                          size_t k,
+                          typename KmerCollector<KMER, KmerExtractor, Container>::Mode mode,
+                          Container *kmers,
+                          const std::vector<typename KmerExtractor::TAlphabet> &suffix) {
+    static_assert(KMER::kBitsPerChar == KmerExtractor::bits_per_char);
+    static_assert(std::is_same_v<typename KMER::WordType, typename Container::key_type>);
+
+    using Mode = typename KmerCollector<KMER, KmerExtractor, Container>::Mode;
+    using TAlphabet = typename KmerExtractor::TAlphabet;
+
+    constexpr bool with_counts
+        = !std::is_same_v<typename KMER::WordType, typename Container::value_type>;
+
+    const size_t num_words = (length + 31) / 32;
+    assert(packed->size() == counts->size() * num_words);
+
+    KmerExtractor kmer_extractor;
+
+    const std::string kNucleotides = "ACGT";
+    std::vector<TAlphabet> codes(kNucleotides.size());
+    for (size_t c = 0; c < kNucleotides.size(); ++c) {
+        codes[c] = kmer_extractor.encode(kNucleotides[c]);
+    }
+
+    std::vector<TAlphabet> seq(length);
+    std::vector<TAlphabet> rev_comp(mode == Mode::BOTH ? length : 0);
+    std::string sequence;
+
+    Vector<KMER> buffer;
+    buffer.reserve(kBufferSize);
+    Vector<typename Container::value_type> buffer_to_insert;
+    buffer_to_insert.reserve(kBufferSize);
+
+    for (size_t i = 0; i < counts->size(); ++i) {
+        const uint64_t *words = packed->data() + i * num_words + num_words - 1;
+        for (size_t j = 0; j < length; ++j) {
+            size_t pos = length - 1 - j;
+            seq[j] = codes[(*(words - pos / 32) >> (pos % 32 * 2)) & 3];
+        }
+
+        if constexpr(std::is_same_v<KmerExtractor, KmerExtractorBOSS>) {
+            // the BOSS extractor pads sequences with sentinels, so the k-mers
+            // are extracted from strings
+            sequence = kmer_extractor.decode(seq);
+            kmer_extractor.sequence_to_kmers(sequence, k, suffix, &buffer,
+                                             mode == Mode::CANONICAL_ONLY);
+            if (mode == Mode::BOTH) {
+                reverse_complement(sequence.begin(), sequence.end());
+                kmer_extractor.sequence_to_kmers(sequence, k, suffix, &buffer);
+            }
+        } else {
+            kmer_extractor.sequence_to_kmers(seq.data(), seq.data() + length, k,
+                                             suffix, &buffer,
+                                             mode == Mode::CANONICAL_ONLY);
+            if (mode == Mode::BOTH) {
+                const auto &complement_code = kmer_extractor.complement_code();
+                for (size_t j = 0; j < length; ++j) {
+                    rev_comp[j] = complement_code[seq[length - 1 - j]];
+                }
+                kmer_extractor.sequence_to_kmers(rev_comp.data(), rev_comp.data() + length,
+                                                 k, suffix, &buffer);
+            }
+        }
+
+        for (const KMER &kmer : buffer) {
+            if constexpr(with_counts) {
+                buffer_to_insert.emplace_back(kmer.data(),
+                                              std::min((*counts)[i], kmers->max_count()));
+            } else {
+                buffer_to_insert.push_back(kmer.data());
+            }
+        }
+        buffer.resize(0);
+
+        if (buffer_to_insert.size() > 0.9 * kBufferSize) {
+            kmers->insert(buffer_to_insert.begin(), buffer_to_insert.end());
+            buffer_to_insert.resize(0);
+        }
+    }
+
+    if (buffer_to_insert.size())
+        kmers->insert(buffer_to_insert.begin(), buffer_to_insert.end());
+}
+
 template <typename KMER, class KmerExtractor, class Container>
 KmerCollector<KMER, KmerExtractor, Container>
 ::KmerCollector(size_t k,
@@ -227,6 +315,18 @@ void KmerCollector<KMER, KmerExtractor, Container>
     });
 }
 
+template <typename KMER, class KmerExtractor, class Container>
+void KmerCollector<KMER, KmerExtractor, Container>
+::add_packed_kmers(size_t length,
+                   std::vector<uint64_t>&& packed,
+                   std::vector<uint64_t>&& counts) {
+    // pass the batch by pointer to avoid copying it when binding the task
+    thread_pool_.enqueue(extract_packed_kmers<KMER, Extractor, Container>,
+                         std::make_shared<const std::vector<uint64_t>>(std::move(packed)),
+                         std::make_shared<const std::vector<uint64_t>>(std::move(counts)),
+                         length, k_, mode_, kmers_.get(), filter_suffix_encoded_);
+}
+
 template <typename KMER, class KmerExtractor, class Container>
 void KmerCollector<KMER, KmerExtractor, Container>::join() {
     batcher_.process_all_buffered();
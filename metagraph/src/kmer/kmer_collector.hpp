@@ -85,6 +85,15 @@ class KmerCollector {
     void add_sequences(std::vector<std::string>&& sequences);
     void add_sequences(std::vector<std::pair<std::string, uint64_t>>&& sequences);
 
+    // Add k-mers packed with two bits per character (A=0, C=1, G=2, T=3) in
+    // ceil(|length| / 32) words each, with the first character in the most
+    // significant bits, as read by seq_io::read_kmers_packed. The k-mers are
+    // encoded directly, without converting them to strings.
+    // |counts| must store a count for each packed k-mer.
+    void add_packed_kmers(size_t length,
+                          std::vector<uint64_t>&& packed,
+                          std::vector<uint64_t>&& counts);
+
     // FYI: This function should be used only in special cases.
     //      In general, use `add_sequences` if possible, to make use of multiple threads.
     void add_kmer(const KMER &kmer) { kmers_->insert(&kmer.data(), &kmer.data() + 1); }
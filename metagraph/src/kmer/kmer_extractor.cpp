@@ -506,6 +506,26 @@ KmerExtractorTDecl(template <typename KMER> void)
     );
 }
 
+KmerExtractorTDecl(template <typename KMER> void)
+::sequence_to_kmers(const TAlphabet *begin,
+                    const TAlphabet *end,
+                    size_t k,
+                    const std::vector<TAlphabet> &suffix,
+                    Vector<KMER> *kmers,
+                    bool canonical_mode) const {
+    assert(kmers);
+    assert(k);
+    assert(suffix.size() <= k);
+    assert(std::all_of(begin, end, [&](auto c) { return c < alphabet.size(); }));
+
+    ::sequence_to_kmers<KMER>(
+        begin, end, k, suffix,
+        [&kmers](auto kmer) { kmers->push_back(kmer); },
+        canonical_mode ? complement_code_ : std::vector<uint8_t>(),
+        []() { return false; }
+    );
+}
+
 KmerExtractorTDecl(template <typename KMER> Vector<std::pair<KMER, bool>>)
 ::sequence_to_kmers(std::string_view sequence,
                     size_t k,
@@ -574,6 +594,10 @@ void KmerExtractor2Bit \
 ::sequence_to_kmers<KMER>(std::string_view, size_t, \
                           const std::vector<TAlphabet>&, Vector<KMER>*, bool) const; \
 template \
+void KmerExtractor2Bit \
+::sequence_to_kmers<KMER>(const TAlphabet*, const TAlphabet*, size_t, \
+                          const std::vector<TAlphabet>&, Vector<KMER>*, bool) const; \
+template \
 Vector<std::pair<KMER, bool>> KmerExtractor2Bit \
 ::sequence_to_kmers<KMER>(std::string_view, size_t, \
                           bool, const std::vector<TAlphabet>&) const;
@@ -147,6 +147,18 @@ class KmerExtractorT {
                            Vector<KMER> *kmers,
                            bool canonical_mode = false) const;
 
+    /**
+     * The same as above, but for a sequence that is already encoded.
+     * All characters in [begin, end) must be valid k-mer characters.
+     */
+    template <class KMER>
+    void sequence_to_kmers(const TAlphabet *begin,
+                           const TAlphabet *end,
+                           size_t k,
+                           const std::vector<TAlphabet> &suffix,
+                           Vector<KMER> *kmers,
+                           bool canonical_mode = false) const;
+
     /**
      * Extract all k-mers from sequence.
      * Returned pairs are k-mers and flags: `true` for the valid k-mers
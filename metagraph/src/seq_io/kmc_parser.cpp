@@ -1,5 +1,7 @@
 #include "kmc_parser.hpp"
 
+#include <cassert>
+
 #include <kmc_file.h>
 
 #include "common/utils/string_utils.hpp"
@@ -24,6 +26,16 @@ void read_kmers(const std::string &kmc_filename,
                max_count);
 }
 
+static void open_for_listing(const std::string &kmc_filename, CKMCFile *kmc_database) {
+    std::string kmc_base_filename = kmc_filename;
+    for (const auto &suffix : kFileSuffixes) {
+        kmc_base_filename = utils::remove_suffix(kmc_base_filename, suffix);
+    }
+
+    if (!kmc_database->OpenForListing(kmc_base_filename))
+        throw std::runtime_error("Error: Can't open KMC database " + kmc_base_filename);
+}
+
 void read_kmers(const std::string &kmc_filename,
                 const std::function<void(std::string_view, uint64_t)> &callback,
                 bool call_both_from_canonical,
@@ -32,14 +44,8 @@ void read_kmers(const std::string &kmc_filename,
     if (min_count >= max_count)
         return;
 
-    std::string kmc_base_filename = kmc_filename;
-    for (const auto &suffix : kFileSuffixes) {
-        kmc_base_filename = utils::remove_suffix(kmc_base_filename, suffix);
-    }
-
     CKMCFile kmc_database;
-    if (!kmc_database.OpenForListing(kmc_base_filename))
-        throw std::runtime_error("Error: Can't open KMC database " + kmc_base_filename);
+    open_for_listing(kmc_filename, &kmc_database);
 
     kmc_database.SetMinCount(min_count);
     kmc_database.SetMaxCount(max_count - 1);
@@ -61,5 +67,81 @@ void read_kmers(const std::string &kmc_filename,
     kmc_database.Close();
 }
 
+void read_kmers_packed(const std::string &kmc_filename,
+                       const std::function<void(size_t k,
+                                                std::vector<uint64_t>&& kmers,
+                                                std::vector<uint64_t>&& counts)> &callback,
+                       bool call_both_from_canonical,
+                       uint64_t min_count,
+                       uint64_t max_count,
+                       size_t batch_size) {
+    if (min_count >= max_count)
+        return;
+
+    assert(batch_size);
+
+    CKMCFile kmc_database;
+    open_for_listing(kmc_filename, &kmc_database);
+
+    kmc_database.SetMinCount(min_count);
+    kmc_database.SetMaxCount(max_count - 1);
+
+    const size_t k = kmc_database.KmerLength();
+    const size_t num_words = (k + 31) / 32;
+    const bool call_reverse = call_both_from_canonical && kmc_database.GetBothStrands();
+
+    CKmerAPI kmer(k);
+    std::vector<uint64> kmer_words;
+    uint64 count;
+
+    std::vector<uint64_t> kmers;
+    std::vector<uint64_t> counts;
+
+    auto push_kmer = [&]() {
+        kmer.to_long(kmer_words);
+        assert(kmer_words.size() == num_words);
+        kmers.insert(kmers.end(), kmer_words.begin(), kmer_words.end());
+        counts.push_back(count);
+    };
+
+    while (kmc_database.ReadNextKmer(kmer, count)) {
+        if (kmers.empty()) {
+            kmers.reserve(batch_size * num_words);
+            counts.reserve(batch_size);
+        }
+
+        push_kmer();
+        if (call_reverse) {
+            kmer.reverse();
+            push_kmer();
+        }
+
+        if (counts.size() >= batch_size) {
+            callback(k, std::move(kmers), std::move(counts));
+            kmers.clear();
+            counts.clear();
+        }
+    }
+
+    if (counts.size())
+        callback(k, std::move(kmers), std::move(counts));
+
+    kmc_database.Close();
+}
+
+void read_kmer_counts(const std::string &kmc_filename,
+                      const std::function<void(uint64_t count)> &callback) {
+    CKMCFile kmc_database;
+    open_for_listing(kmc_filename, &kmc_database);
+
+    CKmerAPI kmer(kmc_database.KmerLength());
+    uint64 count;
+
+    while (kmc_database.ReadNextKmer(kmer, count)) {
+        callback(count);
+    }
+    kmc_database.Close();
+}
+
 } // namespace seq_io
 } // namespace mtg
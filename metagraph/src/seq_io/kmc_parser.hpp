@@ -4,6 +4,7 @@
 #include <functional>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 
 namespace mtg {
@@ -33,6 +34,26 @@ void read_kmers(const std::string &kmc_filename,
                 uint64_t min_count = 1,
                 uint64_t max_count = -1);
 
+// Read k-mers from KMC database without decoding them to strings.
+// The k-mers are passed in batches of up to |batch_size| k-mers, each packed
+// with two bits per character (A=0, C=1, G=2, T=3) in ceil(k/32) words, with
+// the first character in the most significant bits of the first word.
+// |counts| stores the count for each k-mer in the batch.
+// The arguments |call_both_from_canonical|, |min_count|, |max_count| are
+// the same as in read_kmers.
+void read_kmers_packed(const std::string &kmc_filename,
+                       const std::function<void(size_t k,
+                                                std::vector<uint64_t>&& kmers,
+                                                std::vector<uint64_t>&& counts)> &callback,
+                       bool call_both_from_canonical,
+                       uint64_t min_count = 1,
+                       uint64_t max_count = -1,
+                       size_t batch_size = 100'000);
+
+// Read only the counts of k-mers from KMC database
+void read_kmer_counts(const std::string &kmc_filename,
+                      const std::function<void(uint64_t count)> &callback);
+
 } // namespace seq_io
 } // namespace mtg
 
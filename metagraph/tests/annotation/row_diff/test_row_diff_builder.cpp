@@ -0,0 +1,145 @@
+#include <filesystem>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "../../graph/all/test_dbg_helpers.hpp"
+#include "annotation/binary_matrix/column_sparse/column_major.hpp"
+#include "annotation/binary_matrix/row_diff/row_diff.hpp"
+#include "annotation/row_diff_builder.hpp"
+#include "common/utils/file_utils.hpp"
+#include "graph/representation/succinct/dbg_succinct.hpp"
+
+namespace {
+using namespace mtg;
+using namespace mtg::test;
+using mtg::graph::DeBruijnGraph;
+using mtg::graph::DBGSuccinct;
+
+template <uint8_t width = 0>
+std::vector<uint64_t> load_int_vector_buffer(const std::string &fname) {
+    sdsl::int_vector_buffer<width> buffer(fname, std::ios::in);
+    return std::vector<uint64_t>(buffer.begin(), buffer.end());
+}
+
+// build a graph with more than one block of nodes to process
+std::shared_ptr<DeBruijnGraph> build_large_graph() {
+    std::mt19937 gen(42);
+    std::string sequence(1'500'000, 'A');
+    for (char &c : sequence) {
+        c = "ACGT"[gen() % 4];
+    }
+    return build_graph_batch<DBGSuccinct>(12, { sequence });
+}
+
+TEST(RowDiffBuilder, BuildPredSuccMultipleChunks) {
+    auto graph = build_large_graph();
+    ASSERT_LT(1'000'000u, graph->max_index());
+
+    const auto &boss = dynamic_cast<const DBGSuccinct &>(*graph).get_boss();
+    const auto dummy = boss.mark_all_dummy_edges(1);
+
+    // compute the expected pred/succ sequentially
+    std::vector<uint64_t> succ;
+    std::vector<uint64_t> succ_boundary;
+    std::vector<uint64_t> pred;
+    std::vector<uint64_t> pred_boundary;
+    for (DeBruijnGraph::node_index i = 1; i <= graph->max_index(); ++i) {
+        if (graph->in_graph(i) && !dummy[i]) {
+            if (!dummy[boss.fwd(i)] && !graph->has_no_outgoing(i)) {
+                succ.push_back(graph::AnnotatedDBG::graph_to_anno_index(
+                        annot::row_diff_successor(*graph, i, boss.get_last())));
+                succ_boundary.push_back(0);
+            }
+            if (boss.get_last(i)) {
+                graph->adjacent_incoming_nodes(i, [&](auto p) {
+                    if (!dummy[p]) {
+                        pred.push_back(graph::AnnotatedDBG::graph_to_anno_index(p));
+                        pred_boundary.push_back(0);
+                    }
+                });
+            }
+        }
+        succ_boundary.push_back(1);
+        pred_boundary.push_back(1);
+    }
+
+    // the row-diff successor of each row, if any
+    std::vector<int64_t> next_row(graph->max_index(), -1);
+    for (uint64_t r = 0, i = 0; i < succ_boundary.size(); ++i) {
+        if (succ_boundary[i]) {
+            r++;
+        } else {
+            next_row[r] = succ[i - r];
+        }
+    }
+
+    const uint32_t max_length = 10;
+    for (uint32_t num_threads : { 1, 4 }) {
+        std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_pred_succ");
+        const std::string outfbase = tmp_dir/"graph";
+
+        annot::build_pred_succ(*graph, outfbase, tmp_dir, ".row_count", num_threads);
+
+        EXPECT_EQ(succ, load_int_vector_buffer(outfbase + ".succ"));
+        EXPECT_EQ(succ_boundary, load_int_vector_buffer<1>(outfbase + ".succ_boundary"));
+        EXPECT_EQ(pred, load_int_vector_buffer(outfbase + ".pred"));
+        EXPECT_EQ(pred_boundary, load_int_vector_buffer<1>(outfbase + ".pred_boundary"));
+
+        annot::assign_anchors(*graph, outfbase, tmp_dir, max_length, ".row_reduction",
+                              num_threads);
+
+        annot::matrix::RowDiff<annot::matrix::ColumnMajor> row_diff;
+        row_diff.load_anchor(outfbase + annot::matrix::kRowDiffAnchorExt);
+        const auto &anchor = row_diff.anchor();
+        ASSERT_EQ(graph->max_index(), anchor.size());
+
+        // every row-diff path must reach an anchor or a row without successor
+        for (uint64_t r = 0; r < next_row.size(); ++r) {
+            int64_t v = r;
+            for (uint32_t d = 0; d < max_length && !anchor[v] && next_row[v] >= 0; ++d) {
+                v = next_row[v];
+            }
+            ASSERT_TRUE(anchor[v] || next_row[v] < 0) << r;
+        }
+
+        utils::remove_temp_dir(tmp_dir);
+    }
+}
+
+TEST(RowDiffBuilder, AssignAnchorsSameAsSequential) {
+    auto graph = build_graph_batch<DBGSuccinct>(5, {
+        "ACGTCAGTTGCAACGTACCGT", "CAGTTGCAAGGTCCATGAC", "TTTTTTTTTTGCA"
+    });
+    const auto &boss = dynamic_cast<const DBGSuccinct &>(*graph).get_boss();
+    const uint64_t num_rows = graph->max_index();
+
+    for (uint32_t max_length : { 1, 2, 5 }) {
+        // the anchors assigned by the previous sequential implementation
+        sdsl::bit_vector anchors_bv(num_rows + 1, false);
+        boss.row_diff_traverse(1, max_length, boss.get_last(), &anchors_bv);
+        std::vector<bool> expected(num_rows, false);
+        for (uint64_t i = 1; i < anchors_bv.size(); ++i) {
+            if (anchors_bv[i])
+                expected[graph::AnnotatedDBG::graph_to_anno_index(i)] = true;
+        }
+
+        std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_anchors");
+        const std::string outfbase = tmp_dir/"graph";
+
+        annot::build_pred_succ(*graph, outfbase, tmp_dir, ".row_count", 1);
+        annot::assign_anchors(*graph, outfbase, tmp_dir, max_length, ".row_reduction", 1);
+
+        annot::matrix::RowDiff<annot::matrix::ColumnMajor> row_diff;
+        row_diff.load_anchor(outfbase + annot::matrix::kRowDiffAnchorExt);
+        const auto &anchor = row_diff.anchor();
+        ASSERT_EQ(num_rows, anchor.size());
+        for (uint64_t r = 0; r < num_rows; ++r) {
+            EXPECT_EQ(expected[r], anchor[r]) << max_length << " " << r;
+        }
+
+        utils::remove_temp_dir(tmp_dir);
+    }
+}
+
+} // namespace
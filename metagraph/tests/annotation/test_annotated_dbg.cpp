@@ -1877,6 +1877,39 @@ TYPED_TEST(AnnotatedDBGNoNTest, get_top_labels) {
 }
 #endif
 
+TEST(AnnotatedDBG, get_top_labels_ties_ordered_by_code) {
+    typedef std::vector<std::pair<std::string, size_t>> VectorCounts;
+    const std::string common = "AAACCCGGGTTTACGTACGTAAACCCGGGT";
+    const std::string longer = common + "CAGTCAGT";
+
+    // the labels are encoded in the order of insertion, so E < D < C < B < A
+    auto anno_graph = build_anno_graph<DBGHashFast, annot::ColumnCompressed<>>(
+        11, { common, common, common, common, longer }, { "E", "D", "C", "B", "A" }
+    );
+    const auto &label_encoder = anno_graph->get_annotator().get_label_encoder();
+    ASSERT_LT(label_encoder.encode("E"), label_encoder.encode("D"));
+    ASSERT_LT(label_encoder.encode("B"), label_encoder.encode("A"));
+
+    const size_t num_common = common.size() - 11 + 1;
+    const size_t num_longer = longer.size() - 11 + 1;
+
+    // only the top labels are sorted, the ties must be broken by code
+    // and not by the label string or the original order in the matrix
+    EXPECT_EQ(VectorCounts({ { "A", num_longer } }),
+              anno_graph->get_top_labels(longer, 1));
+    EXPECT_EQ(VectorCounts({ { "A", num_longer }, { "E", num_common } }),
+              anno_graph->get_top_labels(longer, 2));
+    EXPECT_EQ(VectorCounts({ { "A", num_longer },
+                             { "E", num_common },
+                             { "D", num_common } }),
+              anno_graph->get_top_labels(longer, 3));
+    EXPECT_EQ(VectorCounts({ { "A", num_longer },
+                             { "E", num_common },
+                             { "D", num_common },
+                             { "C", num_common } }),
+              anno_graph->get_top_labels(longer, 4));
+}
+
 TEST(AnnotatedDBG, score_kmer_presence_mask) {
     auto anno_graph = build_anno_graph<DBGSuccinct, annot::ColumnCompressed<>>(31, {}, {});
     std::vector<std::pair<sdsl::bit_vector, int32_t>> results {
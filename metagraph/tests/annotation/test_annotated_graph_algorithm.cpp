@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include <random>
 #include <unordered_set>
 
 #include "../graph/all/test_dbg_helpers.hpp"
@@ -126,6 +127,51 @@ TYPED_TEST(MaskedDeBruijnGraphAlgorithm, MaskIndicesByLabelOverlap) {
     }
 }
 
+TYPED_TEST(MaskedDeBruijnGraphAlgorithm, MaskIndicesByLabelManyNodes) {
+    typedef typename TypeParam::first_type Graph;
+    typedef typename TypeParam::second_type Annotation;
+    // the graph has more nodes than a single range of nodes counted at once
+    const size_t k = 11;
+    std::mt19937 gen(42);
+    std::vector<std::string> sequences(2, std::string(100'000, 'A'));
+    for (auto &sequence : sequences) {
+        for (char &c : sequence) {
+            c = "ACGT"[gen() % 4];
+        }
+    }
+    const std::vector<std::string> labels { "A", "B" };
+    auto anno_graph = build_anno_graph<Graph, Annotation>(k, sequences, labels);
+
+    // all k-mers from the in-label and none from the out-label
+    std::unordered_set<std::string> ref_kmers;
+    for (size_t i = 0; i + k <= sequences[0].size(); ++i) {
+        ref_kmers.insert(sequences[0].substr(i, k));
+    }
+    for (size_t i = 0; i + k <= sequences[1].size(); ++i) {
+        ref_kmers.erase(sequences[1].substr(i, k));
+    }
+
+    DifferentialAssemblyConfig config {
+        .label_mask_in_unitig_fraction = 0.0,
+        .label_mask_in_kmer_fraction = 1.0,
+        .label_mask_out_unitig_fraction = 1.0,
+        .label_mask_out_kmer_fraction = 0.0,
+        .label_mask_other_unitig_fraction = 1.0
+    };
+
+    for (size_t num_threads : { 1, 4 }) {
+        auto masked_dbg = mask_nodes_by_label(*anno_graph, { "A" }, { "B" }, {}, {},
+                                              config, num_threads);
+
+        std::unordered_set<std::string> obs_kmers;
+        masked_dbg->call_kmers([&](auto, const std::string &kmer) {
+            obs_kmers.insert(kmer);
+        });
+
+        EXPECT_EQ(ref_kmers, obs_kmers) << num_threads;
+    }
+}
+
 template <class Graph, class Annotation = ColumnCompressed<>>
 void test_mask_unitigs(double inlabel_fraction,
                        double outlabel_fraction,
@@ -1,4 +1,5 @@
 #include <random>
+#include <numeric>
 
 #include "gtest/gtest.h"
 
@@ -32,6 +33,34 @@ TEST(ColumnCompressed, add_label_random_with_caching) {
     }
 }
 
+TEST(ColumnCompressed, add_labels_concurrent) {
+    const size_t num_rows = 10'000;
+    const size_t num_labels = 5;
+    for (size_t cache_size : { 1, 2, 10 }) {
+        annot::ColumnCompressed<> annotation(num_rows, cache_size);
+
+        ThreadPool thread_pool(8);
+        for (size_t begin = 0; begin < num_rows; begin += 100) {
+            thread_pool.enqueue([&,begin]() {
+                std::vector<uint64_t> indices(100);
+                std::iota(indices.begin(), indices.end(), begin);
+                for (size_t l = 0; l < num_labels; ++l) {
+                    annotation.add_labels(indices, { "Label" + std::to_string(l) });
+                }
+            });
+        }
+        thread_pool.join();
+
+        ASSERT_EQ(num_labels, annotation.num_labels());
+        for (size_t l = 0; l < num_labels; ++l) {
+            EXPECT_EQ(num_rows, annotation.get_column("Label" + std::to_string(l)).num_set_bits());
+        }
+        for (size_t i = 0; i < num_rows; i += 100) {
+            ASSERT_EQ(num_labels, annotation.get_labels(i).size());
+        }
+    }
+}
+
 TEST(ColumnCompressed, RenameColumnsMerge) {
     annot::ColumnCompressed<> annotation(5);
     annotation.add_labels({ 0 }, { "Label0", "Label2", "Label8" });
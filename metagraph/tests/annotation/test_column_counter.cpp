@@ -0,0 +1,120 @@
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "annotation/binary_matrix/base/column_counter.hpp"
+#include "annotation/binary_matrix/row_sparse/row_sparse.hpp"
+
+
+namespace {
+
+using namespace mtg;
+using namespace mtg::annot::matrix;
+
+typedef BinaryMatrix::SetBitPositions SetBitPositions;
+
+
+std::vector<SetBitPositions> generate_rows(size_t num_rows,
+                                           size_t num_columns,
+                                           double density) {
+    std::mt19937 gen(42);
+    std::bernoulli_distribution bit(density);
+
+    std::vector<SetBitPositions> rows(num_rows);
+    for (auto &row : rows) {
+        for (BinaryMatrix::Column j = 0; j < num_columns; ++j) {
+            if (bit(gen))
+                row.push_back(j);
+        }
+    }
+    return rows;
+}
+
+std::vector<std::pair<BinaryMatrix::Row, size_t>>
+generate_index_counts(size_t num_rows, size_t num_queries) {
+    std::mt19937 gen(43);
+    std::uniform_int_distribution<BinaryMatrix::Row> row(0, num_rows - 1);
+    std::uniform_int_distribution<size_t> count(1, 5);
+
+    std::vector<std::pair<BinaryMatrix::Row, size_t>> index_counts;
+    for (size_t i = 0; i < num_queries; ++i) {
+        index_counts.emplace_back(row(gen), count(gen));
+    }
+    return index_counts;
+}
+
+RowSparse build_row_sparse(const std::vector<SetBitPositions> &rows,
+                           size_t num_columns) {
+    uint64_t num_relations = 0;
+    for (const auto &row : rows) {
+        num_relations += row.size();
+    }
+    return RowSparse([&](const auto &callback) {
+                         for (const auto &row : rows) {
+                             callback(row);
+                         }
+                     },
+                     num_columns, rows.size(), num_relations);
+}
+
+
+TEST(ColumnCounter, DenseAndSparseAreSame) {
+    const size_t num_columns = 200;
+    const auto rows = generate_rows(100, num_columns, 0.1);
+    const auto index_counts = generate_index_counts(rows.size(), 500);
+
+    ColumnCounter dense(num_columns);
+    ColumnCounter sparse(num_columns, 0);
+    ASSERT_TRUE(dense.is_dense());
+    ASSERT_FALSE(sparse.is_dense());
+
+    std::vector<size_t> expected(num_columns, 0);
+    for (const auto &[i, count] : index_counts) {
+        dense.add(rows[i], count);
+        sparse.add(rows[i], count);
+        for (auto j : rows[i]) {
+            expected[j] += count;
+        }
+    }
+
+    for (size_t min_count : { 1, 2, 10, 50, 100, 1000 }) {
+        std::vector<std::pair<BinaryMatrix::Column, size_t>> expected_result;
+        for (BinaryMatrix::Column j = 0; j < num_columns; ++j) {
+            if (expected[j] >= min_count)
+                expected_result.emplace_back(j, expected[j]);
+        }
+
+        EXPECT_EQ(expected_result, dense.get(min_count)) << min_count;
+        EXPECT_EQ(expected_result, sparse.get(min_count)) << min_count;
+    }
+}
+
+TEST(ColumnCounter, Empty) {
+    ColumnCounter dense(10);
+    ColumnCounter sparse(10, 0);
+    EXPECT_EQ(0u, dense.get(1).size());
+    EXPECT_EQ(0u, sparse.get(1).size());
+}
+
+TEST(ColumnCounter, SumRowsSameForDenseAndSparse) {
+    const size_t num_columns = 200;
+    const auto rows = generate_rows(100, num_columns, 0.1);
+    const auto index_counts = generate_index_counts(rows.size(), 500);
+
+    // the same set bits, but too many columns for the dense counter
+    const auto dense = build_row_sparse(rows, num_columns);
+    const auto sparse = build_row_sparse(rows, ColumnCounter::kMaxDenseColumns + 1);
+    ASSERT_TRUE(ColumnCounter(dense.num_columns()).is_dense());
+    ASSERT_FALSE(ColumnCounter(sparse.num_columns()).is_dense());
+
+    for (size_t min_count : { 0, 1, 2, 10, 50, 100, 1000 }) {
+        auto result = dense.sum_rows(index_counts, min_count);
+        EXPECT_TRUE(std::is_sorted(result.begin(), result.end(), utils::LessFirst()));
+        for (const auto &[j, count] : result) {
+            EXPECT_LE(std::max(min_count, (size_t)1), count);
+        }
+        EXPECT_EQ(result, sparse.sum_rows(index_counts, min_count)) << min_count;
+    }
+}
+
+} // namespace
@@ -375,6 +375,62 @@ TEST(RowDiff, ConvertFromColumnCompressedSameLabelsMultipleColumns) {
     std::filesystem::remove_all(dst_dir);
 }
 
+TEST(RowDiff, ConvertFromColumnCompressedManyColumnsSmallMemory) {
+    const auto dst_dir = std::filesystem::path(test_dump_basename)/"row_diff_many_col";
+    const std::string graph_fname
+            = dst_dir/(std::string("graph") + graph::DBGSuccinct::kExtension);
+    std::filesystem::remove_all(dst_dir);
+    std::filesystem::create_directories(dst_dir);
+
+    std::unique_ptr<graph::DBGSuccinct> graph = create_graph(3, { "ACGTCAC" });
+    graph->serialize(graph_fname);
+
+    // 10 files with 4 columns each, every column needs at least 100 KB for
+    // its buffer, so only two files fit in a batch with 1 MB of memory
+    const size_t num_files = 10;
+    const size_t num_columns_per_file = 4;
+    std::vector<std::string> annot_fnames;
+    for (size_t f = 0; f < num_files; ++f) {
+        ColumnCompressed source_annot(graph->max_index());
+        for (size_t c = 0; c < num_columns_per_file; ++c) {
+            std::vector<uint64_t> edges;
+            for (uint64_t i = (f + c) % 2; i < graph->max_index(); i += 2) {
+                edges.push_back(i);
+            }
+            source_annot.add_labels(edges, { "Label" + std::to_string(f) + "_" + std::to_string(c) });
+        }
+        annot_fnames.push_back(dst_dir/("anno" + std::to_string(f) + ColumnCompressed<>::kExtension));
+        source_annot.serialize(annot_fnames.back());
+    }
+
+    convert_to_row_diff(annot_fnames, graph_fname, 1e6, 2, dst_dir, dst_dir, RowDiffStage::COMPUTE_REDUCTION);
+    convert_to_row_diff(annot_fnames, graph_fname, 1e6, 2, dst_dir, dst_dir, RowDiffStage::CONVERT);
+
+    for (size_t f = 0; f < num_files; ++f) {
+        std::string rd_anno = dst_dir/("anno" + std::to_string(f) + RowDiffColumnAnnotator::kExtension);
+        ASSERT_TRUE(std::filesystem::exists(rd_anno));
+        RowDiffColumnAnnotator annotator({}, graph.get());
+        annotator.load(rd_anno);
+        const_cast<matrix::RowDiff<matrix::ColumnMajor> &>(annotator.get_matrix())
+                .load_anchor(graph_fname + matrix::kRowDiffAnchorExt);
+
+        ASSERT_EQ(num_columns_per_file, annotator.num_labels());
+        ASSERT_EQ(graph->max_index(), annotator.num_objects());
+
+        graph->call_nodes([&](uint64_t node_idx) {
+            uint64_t i = graph_to_anno_index(node_idx);
+            std::vector<std::string> expected;
+            for (size_t c = 0; c < num_columns_per_file; ++c) {
+                if (i % 2 == (f + c) % 2)
+                    expected.push_back("Label" + std::to_string(f) + "_" + std::to_string(c));
+            }
+            EXPECT_THAT(annotator.get_labels(i), UnorderedElementsAreArray(expected))
+                << f << " " << i;
+        });
+    }
+    std::filesystem::remove_all(dst_dir);
+}
+
 void test_row_diff(uint32_t k,
                    uint32_t max_depth,
                    const std::vector<std::string> &sequences,
@@ -560,6 +616,109 @@ TEST(RowDiff, ConvertFromColumnCompressed2BigLoops) {
     test_row_diff_separate_columns(10, 3, sequences, annotations, "column.diff.2bigloops");
 }
 
+TEST(RowDiff, MergeNewColumns) {
+    const auto dst_dir = std::filesystem::path(test_dump_basename)/"column.diff.merge";
+    const std::string graph_fname
+            = dst_dir/(std::string("graph") + graph::DBGSuccinct::kExtension);
+
+    std::filesystem::remove_all(dst_dir);
+    std::filesystem::create_directories(dst_dir);
+
+    auto graph = std::make_unique<graph::DBGSuccinct>(4);
+    graph->add_sequence("ATCGGAAGAGCACACGTCTGAACTCCAGACA");
+    graph->add_sequence("TGTCTGGAGTTTCGTAGCGGCGGCTAGTGCG");
+    graph->mask_dummy_kmers(1, false);
+    graph->serialize(graph_fname);
+
+    const std::vector<std::string> labels = { "L0", "L1", "L2" };
+    std::vector<std::string> rd_fnames;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        ColumnCompressed initial_annotation(graph->max_index());
+        graph->call_nodes([&](auto node) {
+            if (graph->rank_node(node) % (i + 2))
+                initial_annotation.add_labels({ graph_to_anno_index(node) }, { labels[i] });
+        });
+        std::string annot_fname = dst_dir/(labels[i] + ColumnCompressed<>::kExtension);
+        initial_annotation.serialize(annot_fname);
+        rd_fnames.push_back(dst_dir/(labels[i] + RowDiffColumnAnnotator::kExtension));
+    }
+
+    // transform the first two columns, then the last one with the same anchors
+    std::vector<std::string> old_fnames = { dst_dir/("L0" + ColumnCompressed<>::kExtension),
+                                            dst_dir/("L1" + ColumnCompressed<>::kExtension) };
+    convert_to_row_diff(old_fnames, graph_fname, 1e9, 3, dst_dir, dst_dir, RowDiffStage::COMPUTE_REDUCTION);
+    convert_to_row_diff(old_fnames, graph_fname, 1e9, 3, dst_dir, dst_dir, RowDiffStage::CONVERT);
+    convert_to_row_diff({ dst_dir/("L2" + ColumnCompressed<>::kExtension) },
+                        graph_fname, 1e9, 3, dst_dir, dst_dir, RowDiffStage::CONVERT);
+
+    auto [anchors_file, fork_succ_file] = get_anchors_and_fork_fnames(graph_fname);
+
+    auto check = [&](const MultiLabelAnnotation<std::string> &annotator) {
+        ASSERT_EQ(labels.size(), annotator.num_labels());
+        ASSERT_EQ(graph->max_index(), annotator.num_objects());
+        graph->call_nodes([&](auto node) {
+            std::vector<std::string> expected;
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (graph->rank_node(node) % (i + 2))
+                    expected.push_back(labels[i]);
+            }
+            EXPECT_THAT(annotator.get_labels(graph_to_anno_index(node)),
+                        UnorderedElementsAreArray(expected));
+        });
+    };
+
+    {
+        merge_row_diff<RowDiffColumnAnnotator>(rd_fnames, dst_dir/"merged");
+        RowDiffColumnAnnotator annotator({}, graph.get());
+        ASSERT_TRUE(annotator.load(dst_dir/"merged"));
+        auto &rd_matrix
+                = const_cast<matrix::RowDiff<matrix::ColumnMajor> &>(annotator.get_matrix());
+        rd_matrix.load_anchor(anchors_file);
+        rd_matrix.load_fork_succ(fork_succ_file);
+        check(annotator);
+    }
+    {
+        std::vector<std::string> brwt_fnames;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            RowDiffColumnAnnotator column_annotator;
+            ASSERT_TRUE(column_annotator.load(rd_fnames[i]));
+            auto annotator = convert_to_simple_BRWT(std::move(column_annotator));
+            auto &rd_matrix
+                    = const_cast<matrix::RowDiff<matrix::BRWT> &>(annotator->get_matrix());
+            rd_matrix.load_anchor(anchors_file);
+            rd_matrix.load_fork_succ(fork_succ_file);
+            brwt_fnames.push_back(dst_dir/(labels[i] + RowDiffBRWTAnnotator::kExtension));
+            annotator->serialize(brwt_fnames.back());
+        }
+
+        merge_row_diff<RowDiffBRWTAnnotator>(brwt_fnames, dst_dir/"merged", 2);
+        RowDiffBRWTAnnotator annotator;
+        ASSERT_TRUE(annotator.load(dst_dir/"merged"));
+        const_cast<matrix::RowDiff<matrix::BRWT> &>(annotator.get_matrix())
+                .set_graph(graph.get());
+        check(annotator);
+    }
+    {
+        convert_to_row_diff<RowDiffDiskAnnotator>({ rd_fnames[0], rd_fnames[1] },
+                                                  graph_fname, dst_dir/"old", 1, 1e9);
+        convert_to_row_diff<RowDiffDiskAnnotator>({ rd_fnames[2] },
+                                                  graph_fname, dst_dir/"new", 1, 1e9);
+
+        merge_row_diff<RowDiffDiskAnnotator>(
+            { dst_dir/("old" + RowDiffDiskAnnotator::kExtension),
+              dst_dir/("new" + RowDiffDiskAnnotator::kExtension) },
+            dst_dir/"merged", 2
+        );
+        RowDiffDiskAnnotator annotator;
+        ASSERT_TRUE(annotator.load(dst_dir/"merged"));
+        const_cast<matrix::RowDiff<matrix::RowDisk> &>(annotator.get_matrix())
+                .set_graph(graph.get());
+        check(annotator);
+    }
+
+    std::filesystem::remove_all(dst_dir);
+}
+
 // TEST(ConvertFromColumnCompressedEmpty, to_BinRelWT) {
 //     ColumnCompressed<> empty_column_annotator(5);
 //     auto empty_annotation = convert<BinRelWTAnnotator>(
@@ -305,4 +305,37 @@ TYPED_TEST(BinaryMatrixTest, AllMixed6) {
     test_matrix(build_matrix_from_columns<TypeParam>(std::move(copy), num_rows), columns);
 }
 
+
+template <typename BinMat>
+class RainbowMatrixTest : public ::testing::Test { };
+typedef ::testing::Types<Rainbow<BRWT>, Rainbowfish> RainbowMatTypes;
+TYPED_TEST_SUITE(RainbowMatrixTest, RainbowMatTypes);
+
+TYPED_TEST(RainbowMatrixTest, RowCache) {
+    const size_t num_rows = 50;
+    for (bool warm_up : { false, true }) {
+        for (size_t cache_size : { 1, 3, 100 }) {
+            BitVectorPtrArray columns, copy;
+            for (size_t j = 0; j < 5; ++j) {
+                sdsl::bit_vector bv(num_rows, 0);
+                for (size_t i = 0; i < num_rows; ++i) {
+                    bv[i] = i % (j + 2) == 0;
+                }
+                columns.emplace_back(new bit_vector_stat(std::move(bv)));
+                copy.push_back(columns.back()->copy());
+            }
+
+            auto matrix = build_matrix_from_columns<TypeParam>(std::move(copy), num_rows);
+            matrix.set_row_cache(cache_size, warm_up);
+
+            // the second pass reads the rows cached by the first one
+            test_matrix(matrix, columns);
+            test_matrix(matrix, columns);
+
+            if (cache_size >= matrix.num_distinct_rows())
+                EXPECT_LT(0u, matrix.num_cache_hits());
+        }
+    }
+}
+
 } // namespace
@@ -1,4 +1,7 @@
+#include <filesystem>
+#include <fstream>
 #include <random>
+#include <sstream>
 
 #include "gtest/gtest.h"
 
@@ -6,6 +9,7 @@
 
 #include "annotation/binary_matrix/multi_brwt/brwt.hpp"
 #include "annotation/binary_matrix/multi_brwt/brwt_builders.hpp"
+#include "common/utils/file_utils.hpp"
 
 
 namespace {
@@ -74,4 +78,171 @@ TYPED_TEST(BinaryMatrixBRWTTest, ArityTwoCol) {
     }
 }
 
+TEST(BRWT, CallColumnsMultiLevel) {
+    const uint64_t num_rows = 2000;
+    std::vector<std::vector<uint64_t>> set_bits(4);
+    // the first two columns are set only in the first half of the rows
+    for (uint64_t i = 0; i < 1000; i += 2) {
+        set_bits[0].push_back(i);
+    }
+    set_bits[1] = { 0, 100, 200 };
+    for (uint64_t i = 1000; i < num_rows; ++i) {
+        if (i % 3)
+            set_bits[2].push_back(i);
+        if (i % 5 == 0)
+            set_bits[3].push_back(i);
+    }
+
+    BitVectorPtrArray columns;
+    for (const auto &bits : set_bits) {
+        sdsl::bit_vector column(num_rows, false);
+        for (uint64_t i : bits) {
+            column[i] = true;
+        }
+        columns.emplace_back(new bit_vector_stat(std::move(column)));
+    }
+
+    // root + 2 internal nodes + 4 leaves. The few rows of the second column
+    // are lifted with select queries, and those of the first column with a scan.
+    auto matrix = BRWTBottomUpBuilder::build(std::move(columns),
+                                             BRWTBottomUpBuilder::get_basic_partitioner(2));
+    ASSERT_EQ(7u, matrix.num_nodes());
+
+    const std::vector<BRWT::Column> queries { 3, 1, 0, 2, 1, 3 };
+    for (size_t num_threads : { 1, 4 }) {
+        std::vector<std::vector<uint64_t>> result(queries.size());
+        matrix.call_columns(queries, [&](size_t i, const bitmap &rows) {
+            rows.call_ones([&](uint64_t row) { result[i].push_back(row); });
+        }, num_threads);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(set_bits[queries[i]], result[i]) << num_threads << " " << i;
+            EXPECT_EQ(matrix.get_column(queries[i]), result[i]) << num_threads << " " << i;
+        }
+    }
+}
+
+TEST(BRWT, QueryLoadedWithMmap) {
+    const uint64_t num_rows = 5000;
+    const uint64_t num_columns = 6;
+    std::mt19937 gen(42);
+    std::bernoulli_distribution bit(0.1);
+
+    std::vector<std::vector<BRWT::Row>> set_bits(num_columns);
+    BitVectorPtrArray columns;
+    for (uint64_t j = 0; j < num_columns; ++j) {
+        sdsl::bit_vector column(num_rows, false);
+        for (uint64_t i = 0; i < num_rows; ++i) {
+            if (bit(gen)) {
+                column[i] = true;
+                set_bits[j].push_back(i);
+            }
+        }
+        columns.emplace_back(new bit_vector_stat(std::move(column)));
+    }
+
+    {
+        auto matrix = BRWTBottomUpBuilder::build(std::move(columns),
+                                                 BRWTBottomUpBuilder::get_basic_partitioner(2));
+        ASSERT_LT(num_columns + 1, matrix.num_nodes());
+        std::ofstream out(test_dump_basename, std::ios::binary);
+        matrix.serialize(out);
+    }
+
+    BRWT matrix;
+    {
+        auto in = utils::open_ifstream(test_dump_basename, true);
+        ASSERT_TRUE(matrix.load(*in));
+    }
+    ASSERT_EQ(num_rows, matrix.num_rows());
+    ASSERT_EQ(num_columns, matrix.num_columns());
+
+#ifdef __linux__
+    // the stream is closed, so the file can only be mapped by the node vectors
+    const std::string path = std::filesystem::canonical(test_dump_basename);
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    bool mapped = false;
+    while (std::getline(maps, line)) {
+        if (line.find(path) != std::string::npos)
+            mapped = true;
+    }
+    EXPECT_TRUE(mapped) << "the loaded matrix doesn't map " << path;
+#endif
+
+    for (uint64_t j = 0; j < num_columns; ++j) {
+        EXPECT_EQ(set_bits[j], matrix.get_column(j)) << j;
+    }
+
+    std::vector<BRWT::Row> rows;
+    std::vector<BRWT::SetBitPositions> expected;
+    for (BRWT::Row i = 0; i < num_rows; i += 7) {
+        rows.push_back(i);
+        expected.emplace_back();
+        for (uint64_t j = 0; j < num_columns; ++j) {
+            if (std::binary_search(set_bits[j].begin(), set_bits[j].end(), i))
+                expected.back().push_back(j);
+        }
+    }
+    EXPECT_EQ(expected, matrix.get_rows(rows));
+}
+
+BRWT build_dense_brwt(uint64_t num_rows, uint64_t num_columns) {
+    std::mt19937 gen(42);
+    // the index vectors of dense columns are nearly full, so most internal
+    // nodes are worth removing
+    std::bernoulli_distribution bit(0.9);
+
+    BitVectorPtrArray columns;
+    for (uint64_t j = 0; j < num_columns; ++j) {
+        sdsl::bit_vector column(num_rows, false);
+        for (uint64_t i = 0; i < num_rows; ++i) {
+            column[i] = bit(gen);
+        }
+        columns.emplace_back(new bit_vector_stat(std::move(column)));
+    }
+
+    return BRWTBottomUpBuilder::build(std::move(columns),
+                                      BRWTBottomUpBuilder::get_basic_partitioner(2));
+}
+
+std::string serialize_to_string(const BRWT &matrix) {
+    std::ostringstream out;
+    matrix.serialize(out);
+    return out.str();
+}
+
+TEST(BRWT, RelaxInParallelSameAsSequential) {
+    const uint64_t num_rows = 10000;
+    const uint64_t num_columns = 16;
+    const BRWT original = build_dense_brwt(num_rows, num_columns);
+    ASSERT_EQ(2 * num_columns - 1, original.num_nodes());
+
+    for (uint64_t max_arity : { 2, 3, 4, 8, -1 }) {
+        BRWT sequential = build_dense_brwt(num_rows, num_columns);
+        BRWTOptimizer::relax(&sequential, max_arity, 1);
+        if (max_arity > 2)
+            EXPECT_GT(original.num_nodes(), sequential.num_nodes()) << max_arity;
+
+        const std::string expected = serialize_to_string(sequential);
+
+        // the memory caps allow no concurrent copies, at most two, and any number
+        for (size_t max_memory : { (size_t)1, (size_t)(num_rows / 8 * 4), (size_t)-1 }) {
+            for (size_t num_threads : { 1, 2, 4 }) {
+                BRWT matrix = build_dense_brwt(num_rows, num_columns);
+                BRWTOptimizer::relax(&matrix, max_arity, num_threads, max_memory);
+
+                EXPECT_EQ(sequential.num_nodes(), matrix.num_nodes())
+                    << max_arity << " " << max_memory << " " << num_threads;
+                EXPECT_EQ(expected, serialize_to_string(matrix))
+                    << max_arity << " " << max_memory << " " << num_threads;
+                for (uint64_t j = 0; j < num_columns; ++j) {
+                    EXPECT_EQ(original.get_column(j), matrix.get_column(j))
+                        << max_arity << " " << max_memory << " " << num_threads << " " << j;
+                }
+            }
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,93 @@
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "../graph/all/test_dbg_helpers.hpp"
+#include "cli/build.hpp"
+#include "cli/config/config.hpp"
+#include "common/utils/file_utils.hpp"
+#include "graph/representation/hash/dbg_sshash.hpp"
+
+
+namespace {
+
+#if ! _PROTEIN_GRAPH
+
+using namespace mtg;
+using namespace mtg::test;
+using mtg::graph::DBGSSHash;
+
+std::set<std::string> get_kmers(const DeBruijnGraph &graph) {
+    std::set<std::string> kmers;
+    graph.call_kmers([&](auto, const std::string &kmer) { kmers.insert(kmer); });
+    return kmers;
+}
+
+void write_fasta(const std::string &fname, const std::vector<std::string> &reads) {
+    std::ofstream out(fname);
+    for (const auto &read : reads) {
+        out << ">read\n" << read << "\n";
+    }
+}
+
+TEST(build_graph, SSHashFromOverlappingReadsInTwoFiles) {
+    const size_t k = 11;
+    // the reads overlap within and across the files
+    const std::vector<std::string> first {
+        "ACTAGCTAGCTAGCTAGCTAGCAATTTTTTT",
+        "GCTAGCTAGCAATTTTTTTTTTTTCCCCCCC",
+    };
+    const std::vector<std::string> second {
+        "ACTAGCTAGCTAGCTAGCTAGCAATTTTTTT",
+        "TTTTTTTCCCCCCCCCCCGGGATCGATCGAT",
+    };
+
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_build");
+    const std::string first_file = tmp_dir/"first.fa";
+    const std::string second_file = tmp_dir/"second.fa";
+    write_fasta(first_file, first);
+    write_fasta(second_file, second);
+
+    std::vector<std::string> reads = first;
+    reads.insert(reads.end(), second.begin(), second.end());
+
+    for (std::string mode : { "basic", "canonical" }) {
+        const std::string outfbase = tmp_dir/("graph_" + mode);
+        std::vector<std::string> args {
+            "metagraph", "build", "--graph", "sshash", "--mode", mode,
+            "-k", std::to_string(k), "-o", outfbase, first_file, second_file
+        };
+        std::vector<char *> argv;
+        for (auto &arg : args) {
+            argv.push_back(arg.data());
+        }
+
+        cli::Config config(argv.size(), argv.data());
+        ASSERT_EQ(0, cli::build_graph(&config));
+
+        DBGSSHash graph(k);
+        ASSERT_TRUE(graph.load(outfbase));
+
+        auto reference = build_graph<DBGHashFast>(k, reads, cli::Config::string_to_graphmode(mode));
+        EXPECT_EQ(reference->num_nodes(), graph.num_nodes()) << mode;
+        EXPECT_EQ(get_kmers(*reference), get_kmers(graph)) << mode;
+
+        // every k-mer of the reads is found in the graph
+        for (const auto &read : reads) {
+            size_t num_kmers = 0;
+            graph.map_to_nodes_sequentially(read, [&](auto node) {
+                EXPECT_NE(DeBruijnGraph::npos, node) << mode << " " << read;
+                ++num_kmers;
+            });
+            EXPECT_EQ(read.size() - k + 1, num_kmers);
+        }
+    }
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+#endif // ! _PROTEIN_GRAPH
+
+} // namespace
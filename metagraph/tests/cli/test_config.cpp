@@ -0,0 +1,38 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cli/config/config.hpp"
+#include "common/utils/file_utils.hpp"
+
+
+namespace {
+
+using namespace mtg;
+
+cli::Config parse(std::vector<std::string> args) {
+    std::vector<char *> argv;
+    for (auto &arg : args) {
+        argv.push_back(arg.data());
+    }
+    return cli::Config(argv.size(), argv.data());
+}
+
+TEST(Config, ServerQueryMmap) {
+    parse({ "metagraph", "server_query", "-i", "graph", "-a", "anno" });
+    EXPECT_TRUE(utils::with_mmap());
+
+    parse({ "metagraph", "server_query", "--no-mmap", "-i", "graph", "-a", "anno" });
+    EXPECT_FALSE(utils::with_mmap());
+
+    // the last flag wins
+    parse({ "metagraph", "server_query", "--no-mmap", "--mmap", "-i", "graph", "-a", "anno" });
+    EXPECT_TRUE(utils::with_mmap());
+
+    // not carried over from a previous parse
+    parse({ "metagraph", "query", "-i", "graph", "-a", "anno", "seqs.fa" });
+    EXPECT_FALSE(utils::with_mmap());
+}
+
+} // namespace
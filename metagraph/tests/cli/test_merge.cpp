@@ -0,0 +1,112 @@
+#include <filesystem>
+
+#include "gtest/gtest.h"
+
+#include "../graph/all/test_dbg_helpers.hpp"
+#include "cli/merge.hpp"
+#include "common/utils/file_utils.hpp"
+#include "graph/graph_extensions/node_weights.hpp"
+#include "graph/representation/succinct/dbg_succinct.hpp"
+
+
+namespace {
+
+using namespace mtg;
+using namespace mtg::test;
+using mtg::graph::DBGSuccinct;
+using mtg::graph::NodeWeights;
+
+// build a graph from |sequence| and assign weight |weight| to each of its k-mers
+void serialize_weighted_graph(size_t k,
+                              const std::string &sequence,
+                              uint64_t weight,
+                              const std::string &fname,
+                              uint8_t count_width = 16) {
+    auto graph = build_graph_batch<DBGSuccinct>(k, { sequence });
+    auto weights = std::make_shared<NodeWeights>(graph->max_index() + 1, count_width);
+    graph->map_to_nodes(sequence, [&](auto node) { weights->add_weight(node, weight); });
+    graph->add_extension(weights);
+    graph->serialize(fname);
+    graph->serialize_extensions(fname);
+}
+
+TEST(merge_weights, OverlappingGraphs) {
+    const size_t k = 5;
+    // the sequences share the k-mers of TTGCATCCG, all other k-mers are unique
+    const std::string first = "AAACGTTGCATCCG";
+    const std::string second = "TTGCATCCGGATTC";
+    const std::string shared = "TTGCATCCG";
+
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_merge");
+    const std::vector<std::string> files {
+        tmp_dir/("first" + std::string(DBGSuccinct::kExtension)),
+        tmp_dir/("second" + std::string(DBGSuccinct::kExtension))
+    };
+    serialize_weighted_graph(k, first, 200, files[0]);
+    serialize_weighted_graph(k, second, 100, files[1]);
+
+    for (uint8_t count_width : { 8, 10 }) {
+        auto merged = std::dynamic_pointer_cast<DBGSuccinct>(
+                build_graph_batch<DBGSuccinct>(k, { first, second }));
+        ASSERT_TRUE(merged);
+
+        cli::merge_weights(merged.get(), files, count_width, 2);
+
+        auto weights = merged->get_extension<NodeWeights>();
+        ASSERT_TRUE(weights);
+        ASSERT_TRUE(weights->is_compatible(*merged));
+
+        // 200 + 100 saturates at 255 with 8 bits, but not with 10 bits
+        const uint64_t shared_weight = count_width == 8 ? 255 : 300;
+        for (size_t i = 0; i + k <= first.size(); ++i) {
+            std::string kmer = first.substr(i, k);
+            bool is_shared = shared.find(kmer) != std::string::npos;
+            EXPECT_EQ(is_shared ? shared_weight : 200,
+                      (*weights)[merged->kmer_to_node(kmer)]) << kmer;
+        }
+        for (size_t i = 0; i + k <= second.size(); ++i) {
+            std::string kmer = second.substr(i, k);
+            bool is_shared = shared.find(kmer) != std::string::npos;
+            EXPECT_EQ(is_shared ? shared_weight : 100,
+                      (*weights)[merged->kmer_to_node(kmer)]) << kmer;
+        }
+    }
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+TEST(merge_weights, CountsAbove32Bits) {
+    const size_t k = 5;
+    const std::string sequence = "AAACGTTGCATCCG";
+    const uint64_t weight = 3'000'000'000;
+
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_merge");
+    const std::vector<std::string> files {
+        tmp_dir/("first" + std::string(DBGSuccinct::kExtension)),
+        tmp_dir/("second" + std::string(DBGSuccinct::kExtension))
+    };
+    serialize_weighted_graph(k, sequence, weight, files[0], 32);
+    serialize_weighted_graph(k, sequence, weight, files[1], 32);
+
+    for (uint8_t count_width : { 32, 33, 64 }) {
+        auto merged = std::dynamic_pointer_cast<DBGSuccinct>(
+                build_graph_batch<DBGSuccinct>(k, { sequence }));
+        ASSERT_TRUE(merged);
+
+        cli::merge_weights(merged.get(), files, count_width, 2);
+
+        auto weights = merged->get_extension<NodeWeights>();
+        ASSERT_TRUE(weights);
+
+        // 2 * 3e9 saturates at 2^32 - 1 with 32 bits, but not with more bits
+        const uint64_t expected = count_width == 32 ? (1llu << 32) - 1 : 2 * weight;
+        for (size_t i = 0; i + k <= sequence.size(); ++i) {
+            std::string kmer = sequence.substr(i, k);
+            EXPECT_EQ(expected, (*weights)[merged->kmer_to_node(kmer)]) << kmer;
+        }
+    }
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+} // namespace
@@ -1,14 +1,22 @@
+#include <random>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "../graph/all/test_dbg_helpers.hpp"
 #include "cli/query.hpp"
+#include "annotation/representation/base/annotation.hpp"
+#include "annotation/representation/column_compressed/annotate_column_compressed.hpp"
 #include "common/vector.hpp"
+#include "graph/annotated_dbg.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
+#include "graph/representation/hash/dbg_hash_fast.hpp"
 
 
 namespace {
 
 using namespace mtg;
+using namespace mtg::test;
 
 TEST(collapse_coord_ranges, empty) {
     std::vector<SmallVector<uint64_t>> tuples = {};
@@ -65,4 +73,109 @@ TEST(collapse_coord_ranges, disjoint) {
               cli::collapse_coord_ranges(longer));
 }
 
+TEST(LabelJsonIndex, find) {
+    annot::LabelEncoder<std::string> label_encoder;
+    label_encoder.insert_and_encode("A;x=1;y=nan");
+    label_encoder.insert_and_encode("B");
+    label_encoder.insert_and_encode("C;x");
+
+    cli::LabelJsonIndex label_json(label_encoder, 2);
+
+    const Json::Value *a = label_json.find("A;x=1;y=nan");
+    ASSERT_TRUE(a);
+    EXPECT_EQ("A", (*a)["sample"].asString());
+    EXPECT_EQ(1., (*a)["properties"]["x"].asDouble());
+    EXPECT_TRUE((*a)["properties"]["y"].isNull());
+
+    // the index is not copied on lookups
+    EXPECT_EQ(a, label_json.find("A;x=1;y=nan"));
+
+    const Json::Value *b = label_json.find("B");
+    ASSERT_TRUE(b);
+    EXPECT_EQ("B", (*b)["sample"].asString());
+    EXPECT_FALSE(b->isMember("properties"));
+
+    // missing or failed to parse
+    EXPECT_FALSE(label_json.find("D;z=a"));
+    EXPECT_FALSE(label_json.find("C;x"));
+}
+
+TEST(LabelJsonIndex, append_to) {
+    annot::LabelEncoder<std::string> label_encoder;
+    label_encoder.insert_and_encode("B");
+    label_encoder.insert_and_encode("C;x");
+
+    cli::LabelJsonIndex label_json(label_encoder, 2);
+
+    Json::Value array(Json::arrayValue);
+    EXPECT_EQ("B", label_json.append_to(&array, "B")["sample"].asString());
+
+    // labels missing in the index are parsed on the fly
+    Json::Value &d = label_json.append_to(&array, "D;z=a");
+    EXPECT_EQ("D", d["sample"].asString());
+    EXPECT_EQ("a", d["properties"]["z"].asString());
+    EXPECT_EQ(2u, array.size());
+
+    EXPECT_THROW(label_json.append_to(&array, "C;x"), std::runtime_error);
+}
+
+std::string random_sequence(std::mt19937 &rng, size_t length) {
+    std::string sequence(length, 'A');
+    for (char &c : sequence) {
+        c = "ACGT"[rng() % 4];
+    }
+    return sequence;
+}
+
+TEST(construct_query_graph, SameContigsForAnyNumberOfThreads) {
+    const size_t k = 11;
+    std::mt19937 rng(1);
+    std::vector<std::string> sequences;
+    for (size_t i = 0; i < 20; ++i) {
+        sequences.push_back(random_sequence(rng, 200));
+    }
+    auto graph = build_graph_batch<graph::DBGHashFast>(k, sequences);
+    graph::AnnotatedDBG anno_graph(graph,
+                                   std::make_unique<annot::ColumnCompressed<>>(graph->max_index()));
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        anno_graph.annotate_sequence(sequences[i], { std::to_string(i % 3) });
+    }
+
+    // substrings of the indexed sequences, partly overlapping each other,
+    // and sequences with mostly missing k-mers
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < 50; ++i) {
+        const std::string &sequence = sequences[rng() % sequences.size()];
+        size_t begin = rng() % 100;
+        queries.push_back(sequence.substr(begin, 50 + rng() % 50));
+        queries.push_back(random_sequence(rng, 30));
+    }
+    auto call_queries = [&](auto callback) {
+        for (const auto &query : queries) {
+            callback(query);
+        }
+    };
+
+    for (bool with_bloom_filter : { false, true }) {
+        if (with_bloom_filter)
+            graph->add_extension(std::make_shared<graph::NodeBloomFilter>(*graph, 8.0));
+
+        std::vector<std::string> expected;
+        for (size_t num_threads : { 1, 2, 4 }) {
+            auto query_graph = cli::construct_query_graph(anno_graph, call_queries, num_threads);
+            std::vector<std::string> contigs;
+            query_graph->get_graph().call_sequences([&](const std::string &contig, const auto &) {
+                contigs.push_back(contig);
+            });
+
+            if (num_threads == 1) {
+                expected = contigs;
+                EXPECT_FALSE(expected.empty());
+            } else {
+                EXPECT_EQ(expected, contigs) << with_bloom_filter << " " << num_threads;
+            }
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,148 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "common/block_table.hpp"
+#include "common/threads/threading.hpp"
+#include "common/utils/file_utils.hpp"
+
+
+namespace {
+
+using mtg::common::BlockTable;
+using mtg::common::BlockTableWriter;
+using mtg::common::BlockIfstream;
+
+const uint64_t kBlockSize = 4096;
+const uint64_t kSection = 500'000;
+
+// write |data| with a table of blocks and a single section at kSection
+std::string write_with_table(const std::filesystem::path &tmp_dir, const std::string &data) {
+    std::string fname = tmp_dir/"blocks";
+    std::ofstream out(fname, std::ios::binary);
+    BlockTableWriter writer(out, kBlockSize);
+    // in pieces crossing the block boundaries, and byte by byte
+    size_t i = 0;
+    for (size_t size = 1; i + size <= data.size() - 10; size = size * 3 + 1) {
+        out.write(data.data() + i, size);
+        i += size;
+    }
+    while (i < data.size()) {
+        out.put(data[i++]);
+    }
+    EXPECT_EQ(data.size(), static_cast<uint64_t>(out.tellp()));
+    writer.append_table({ kSection });
+    return fname;
+}
+
+std::string random_data(size_t size) {
+    std::mt19937 rng(1);
+    std::string data(size, 0);
+    for (char &c : data) {
+        c = rng();
+    }
+    return data;
+}
+
+std::string read_all(std::istream &in) {
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+TEST(BlockTable, NoTable) {
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_block_table");
+    std::string fname = tmp_dir/"no_table";
+    std::ofstream(fname, std::ios::binary) << random_data(100'000);
+
+    EXPECT_FALSE(BlockTable().load(fname));
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+TEST(BlockTable, ReadSections) {
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_block_table");
+    const std::string data = random_data(1'000'003);
+    const std::string fname = write_with_table(tmp_dir, data);
+
+    BlockTable table;
+    ASSERT_TRUE(table.load(fname));
+    EXPECT_EQ(data.size(), table.data_size());
+    EXPECT_EQ(kBlockSize, table.block_size());
+    EXPECT_EQ((data.size() + kBlockSize - 1) / kBlockSize, table.num_blocks());
+    ASSERT_EQ(std::vector<uint64_t>({ kSection }), table.sections());
+
+    ThreadPool thread_pool(4);
+    for (size_t read_ahead : { 1, 3, 10 }) {
+        BlockIfstream first(fname, table, 0, kSection, thread_pool, read_ahead);
+        BlockIfstream second(fname, table, kSection, table.data_size(),
+                             thread_pool, read_ahead);
+        EXPECT_EQ(data.substr(0, kSection), read_all(first));
+        EXPECT_EQ(data.substr(kSection), read_all(second));
+    }
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+TEST(BlockTable, Seek) {
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_block_table");
+    const std::string data = random_data(1'000'003);
+    const std::string fname = write_with_table(tmp_dir, data);
+
+    BlockTable table;
+    ASSERT_TRUE(table.load(fname));
+
+    ThreadPool thread_pool(2);
+    BlockIfstream in(fname, table, 0, table.data_size(), thread_pool, 2);
+    std::string buffer(100, '\0');
+
+    in.seekg(777'777);
+    EXPECT_EQ(777'777, in.tellg());
+    in.read(buffer.data(), buffer.size());
+    EXPECT_EQ(data.substr(777'777, 100), buffer);
+    EXPECT_EQ(777'877, in.tellg());
+
+    // within the current block
+    in.seekg(777'800);
+    in.read(buffer.data(), buffer.size());
+    EXPECT_EQ(data.substr(777'800, 100), buffer);
+
+    // backwards
+    in.seekg(10);
+    in.read(buffer.data(), buffer.size());
+    EXPECT_EQ(data.substr(10, 100), buffer);
+
+    in.seekg(-50, std::ios::end);
+    in.read(buffer.data(), buffer.size());
+    EXPECT_EQ(50, in.gcount());
+    EXPECT_TRUE(in.eof());
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+TEST(BlockTable, CorruptedBlock) {
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_block_table");
+    std::string data = random_data(1'000'003);
+    const std::string fname = write_with_table(tmp_dir, data);
+
+    BlockTable table;
+    ASSERT_TRUE(table.load(fname));
+
+    const uint64_t corrupted = 600'000;
+    {
+        std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(corrupted);
+        file.put(data[corrupted] ^ 1);
+    }
+
+    // the stream ends right before the corrupted block
+    ThreadPool thread_pool(2);
+    BlockIfstream in(fname, table, 0, table.data_size(), thread_pool, 2);
+    EXPECT_EQ(data.substr(0, corrupted - corrupted % kBlockSize), read_all(in));
+
+    utils::remove_temp_dir(tmp_dir);
+}
+
+} // namespace
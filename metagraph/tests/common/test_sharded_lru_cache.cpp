@@ -0,0 +1,81 @@
+#include "common/sharded_lru_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+
+namespace {
+
+using mtg::common::ShardedLRUCache;
+
+TEST(ShardedLRUCache, Empty) {
+    ShardedLRUCache<uint64_t, uint64_t> cache(0);
+    cache.Put(1, 2);
+    EXPECT_FALSE(cache.TryGet(1));
+    EXPECT_EQ(0u, cache.num_hits());
+    EXPECT_EQ(0u, cache.num_misses());
+}
+
+TEST(ShardedLRUCache, PutGet) {
+    ShardedLRUCache<uint64_t, uint64_t> cache(1000);
+    for (uint64_t i = 0; i < 100; ++i) {
+        cache.Put(i, 2 * i);
+    }
+    for (uint64_t i = 0; i < 100; ++i) {
+        auto fetch = cache.TryGet(i);
+        ASSERT_TRUE(fetch);
+        EXPECT_EQ(2 * i, *fetch);
+    }
+    EXPECT_FALSE(cache.TryGet(100));
+    EXPECT_EQ(100u, cache.num_hits());
+    EXPECT_EQ(1u, cache.num_misses());
+}
+
+TEST(ShardedLRUCache, Eviction) {
+    ShardedLRUCache<uint64_t, uint64_t> cache(64, 4);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        cache.Put(i, i);
+    }
+    size_t num_cached = 0;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        if (auto fetch = cache.TryGet(i)) {
+            EXPECT_EQ(i, *fetch);
+            num_cached++;
+        }
+    }
+    EXPECT_LE(num_cached, 64u);
+    // the most recent keys are still cached
+    for (uint64_t i = 996; i < 1000; ++i) {
+        EXPECT_TRUE(cache.TryGet(i));
+    }
+}
+
+TEST(ShardedLRUCache, Concurrent) {
+    ShardedLRUCache<uint64_t, uint64_t> cache(10'000);
+    const size_t num_threads = 8;
+    const uint64_t num_keys = 20'000;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            for (uint64_t i = 0; i < num_keys; ++i) {
+                if (auto fetch = cache.TryGet(i)) {
+                    ASSERT_EQ(3 * i, *fetch);
+                } else {
+                    cache.Put(i, 3 * i);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(num_threads * num_keys, cache.num_hits() + cache.num_misses());
+}
+
+} // namespace
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "common/unix_tools.hpp"
+#include "common/utils/file_utils.hpp"
+
+
+namespace {
+
+#ifdef __linux__
+// the major page faults of this process, read from /proc/self/stat
+uint64_t read_proc_majflt() {
+    std::ifstream in("/proc/self/stat");
+    std::string stat;
+    std::getline(in, stat);
+    // skip the process name, which may contain spaces
+    std::istringstream fields(stat.substr(stat.rfind(')') + 2));
+    // majflt is the 12th field, and the 10th after the name
+    std::string field;
+    for (size_t i = 0; i < 10; ++i) {
+        fields >> field;
+    }
+    return std::stoull(field);
+}
+
+TEST(UnixTools, NumPageInsMatchesProc) {
+    uint64_t before = read_proc_majflt();
+    uint64_t page_ins = get_num_page_ins();
+    uint64_t after = read_proc_majflt();
+    EXPECT_LE(before, page_ins);
+    EXPECT_LE(page_ins, after);
+}
+
+TEST(UnixTools, NumPageInsGrowsWhenReadingEvictedMappedFile) {
+    std::filesystem::path tmp_dir = utils::create_temp_dir("", "test_unix_tools");
+    const std::string fname = tmp_dir/"mapped";
+    const size_t size = 1 << 24;
+    std::ofstream(fname, std::ios::binary) << std::string(size, 'A');
+
+    int fd = open(fname.c_str(), O_RDONLY);
+    ASSERT_NE(-1, fd);
+    // evict the file from the page cache
+    ASSERT_EQ(0, fdatasync(fd));
+    ASSERT_EQ(0, posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT_NE(MAP_FAILED, data);
+
+    // make sure that none of the pages is cached, otherwise reading them
+    // would cause only minor page faults
+    std::vector<unsigned char> resident(size / 4096);
+    ASSERT_EQ(0, mincore(data, size, resident.data()));
+    ASSERT_EQ(0, std::count_if(resident.begin(), resident.end(),
+                               [](unsigned char page) { return page & 1; }));
+
+    uint64_t page_ins = get_num_page_ins();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i += 4096) {
+        sum += static_cast<const char *>(data)[i];
+    }
+    EXPECT_EQ('A' * (size / 4096), sum);
+    EXPECT_LT(page_ins, get_num_page_ins());
+
+    munmap(data, size);
+    close(fd);
+    utils::remove_temp_dir(tmp_dir);
+}
+#endif
+
+} // namespace
@@ -3,11 +3,13 @@
 #define private public
 #define protected public
 
+#include <filesystem>
 #include <set>
 
 #include "../../test_helpers.hpp"
 #include "test_dbg_helpers.hpp"
 #include "graph/graph_extensions/node_weights.hpp"
+#include "graph/graph_extensions/node_bloom_filter.hpp"
 
 
 namespace {
@@ -178,6 +180,59 @@ TYPED_TEST(DeBruijnGraphTest, Weighted) {
     }
 }
 
+TYPED_TEST(DeBruijnGraphTest, MapToNodesWithBloomFilter) {
+    for (size_t k = 3; k < 10; ++k) {
+        const std::vector<std::string> sequences {
+            "AAACACTAGCTAGCATCGACTTTTT", "CGCGCGCGCATCATCAGGGGT"
+        };
+        const std::vector<std::string> queries {
+            "AAACACTAGCTAGCATCGACTTTTT", "ACTAGCTAGCATCGACTTT",
+            "AAACACTAGCTTGCATCGACTTTTT", "CCCCCCCCCCCCCCCCC",
+            "CGCGCGCGCATCATCAGGGGTAAACACTAGC", "CGCGNCGCATCATCA"
+        };
+        auto graph = build_graph<TypeParam>(k, sequences);
+
+        std::vector<std::vector<DeBruijnGraph::node_index>> expected;
+        std::vector<std::vector<DeBruijnGraph::node_index>> expected_seq;
+        for (const auto &query : queries) {
+            expected.push_back(map_to_nodes(*graph, query));
+            expected_seq.push_back(map_to_nodes_sequentially(*graph, query));
+        }
+
+        graph->add_extension(std::make_shared<NodeBloomFilter>(*graph, 4.0));
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(expected[i], map_to_nodes(*graph, queries[i])) << queries[i];
+            EXPECT_EQ(expected_seq[i], map_to_nodes_sequentially(*graph, queries[i])) << queries[i];
+        }
+
+        graph->remove_extension<NodeBloomFilter>();
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(expected[i], map_to_nodes(*graph, queries[i])) << queries[i];
+        }
+    }
+}
+
+TEST(NodeBloomFilter, SerializeWithDotInBaseName) {
+    auto graph = build_graph<DBGHashFast>(5, { "AAACACTAGCTAGCATCGACTTTTT" });
+    NodeBloomFilter filter(*graph, 4.0);
+
+    // only the graph extension is replaced, not the part after the last dot
+    const std::string prefix = test_dump_basename + ".v2";
+    for (const std::string &filename_base : { prefix, prefix + DBGHashFast::kExtension }) {
+        filter.serialize(filename_base);
+        ASSERT_TRUE(std::filesystem::exists(prefix + NodeBloomFilter::kBloomFilterExtension))
+            << filename_base;
+
+        NodeBloomFilter loaded;
+        ASSERT_TRUE(loaded.load(filename_base)) << filename_base;
+        EXPECT_TRUE(loaded.is_compatible(*graph)) << filename_base;
+
+        std::filesystem::remove(prefix + NodeBloomFilter::kBloomFilterExtension);
+    }
+}
+
 TYPED_TEST(DeBruijnGraphTest, ReverseComplement) {
     auto graph1 = build_graph<TypeParam>(12, { "AAAAAAAAAAAAAAAAAAAAAAAAAAAAA" });
     auto graph2 = build_graph<TypeParam>(12, { "AAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
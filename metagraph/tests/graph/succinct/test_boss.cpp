@@ -83,6 +83,10 @@ void test_graph(BOSS *graph, const std::string &last,
     test_graph(graph, last, W, F, BOSS::State::STAT);
     test_graph(graph, last, W, F, BOSS::State::DYN);
     test_graph(graph, last, W, F, BOSS::State::SMALL);
+    test_graph(graph, last, W, F, BOSS::State::FUSED);
+    test_graph(graph, last, W, F, BOSS::State::FUSED);
+    test_graph(graph, last, W, F, BOSS::State::STAT);
+    test_graph(graph, last, W, F, BOSS::State::FUSED);
     test_graph(graph, last, W, F, BOSS::State::DYN);
 }
 
@@ -247,6 +251,90 @@ TEST(BOSS, Serialization) {
     delete graph;
 }
 
+TEST(BOSS, SerializationFused) {
+    gzFile input_p = gzopen(test_fasta.c_str(), "r");
+    kseq_t *read_stream = kseq_init(input_p);
+    ASSERT_TRUE(read_stream);
+
+    BOSSConstructor constructor(3);
+
+    for (size_t i = 1; kseq_read(read_stream) >= 0; ++i) {
+        constructor.add_sequences({ read_stream->seq.s });
+    }
+    kseq_destroy(read_stream);
+    gzclose(input_p);
+
+    BOSS graph(&constructor);
+    graph.switch_state(BOSS::State::FUSED);
+
+    std::ofstream out(test_dump_basename + ".boss", std::ios::binary);
+    graph.serialize(out);
+    out.close();
+
+    BOSS loaded_graph;
+    std::ifstream in(test_dump_basename + ".boss", std::ios::binary);
+    ASSERT_TRUE(loaded_graph.load(in)) << "Can't load the graph";
+    EXPECT_EQ(BOSS::State::FUSED, loaded_graph.get_state());
+    EXPECT_EQ(graph, loaded_graph) << "Loaded graph differs";
+
+    loaded_graph.switch_state(BOSS::State::STAT);
+    EXPECT_EQ(graph, loaded_graph);
+}
+
+TEST(BOSS, FusedQueriesMatchStat) {
+    srand(1);
+
+    // large enough to span several superblocks of the fused layout
+    std::string sequence(100'000, 'A');
+    BOSS stat(12);
+    for (size_t s = 0; s < sequence.size(); ++s) {
+        sequence[s] = stat.alphabet[1 + rand() % 4];
+    }
+    stat.add_sequence(sequence);
+    stat.switch_state(BOSS::State::STAT);
+
+    BOSS fused(12);
+    fused.add_sequence(sequence);
+    fused.switch_state(BOSS::State::FUSED);
+
+    const auto &W_stat = stat.get_W();
+    const auto &W_fused = fused.get_W();
+    const auto &last_stat = stat.get_last();
+    const auto &last_fused = fused.get_last();
+    ASSERT_EQ(W_stat.size(), W_fused.size());
+    ASSERT_LT(1u << 16, W_stat.size());
+
+    for (BOSS::TAlphabet c = 0; c < 2 * stat.alph_size; ++c) {
+        ASSERT_EQ(W_stat.count(c), W_fused.count(c));
+        for (uint64_t r = 1; r <= W_stat.count(c); r += 1 + rand() % 100) {
+            ASSERT_EQ(W_stat.select(c, r), W_fused.select(c, r));
+        }
+    }
+    for (uint64_t r = 1; r <= last_stat.num_set_bits(); r += 1 + rand() % 100) {
+        ASSERT_EQ(last_stat.select1(r), last_fused.select1(r));
+    }
+    for (uint64_t r = 1; r <= last_stat.size() - last_stat.num_set_bits(); r += 1 + rand() % 100) {
+        ASSERT_EQ(last_stat.select0(r), last_fused.select0(r));
+    }
+
+    for (uint64_t i = 0; i < W_stat.size(); i += 1 + rand() % 10) {
+        ASSERT_EQ(W_stat[i], W_fused[i]);
+        ASSERT_EQ(last_stat[i], last_fused[i]);
+        ASSERT_EQ(last_stat.rank1(i), last_fused.rank1(i));
+        ASSERT_EQ(last_stat.next1(i), last_fused.next1(i));
+        ASSERT_EQ(last_stat.prev1(i), last_fused.prev1(i));
+        ASSERT_EQ(W_stat.inverse_select(i), W_fused.inverse_select(i));
+        for (BOSS::TAlphabet c = 0; c < 2 * stat.alph_size; ++c) {
+            ASSERT_EQ(W_stat.rank(c, i), W_fused.rank(c, i));
+            ASSERT_EQ(W_stat.next(i, c), W_fused.next(i, c));
+            ASSERT_EQ(W_stat.prev(i, c), W_fused.prev(i, c));
+        }
+    }
+
+    EXPECT_EQ(last_stat.to_vector(), last_fused.to_vector());
+    EXPECT_EQ(W_stat.to_vector(), W_fused.to_vector());
+}
+
 TEST(BOSS, AddSequenceSimplePath) {
     for (size_t k = 1; k < 10; ++k) {
         BOSS graph(k);
@@ -249,6 +249,51 @@ TEST(BOSSConstruct, ConstructionEQAppendingCanonical) {
 }
 #endif
 
+#if ! _PROTEIN_GRAPH
+// pack as in KMC databases: two bits per character, with the first character
+// in the most significant bits of the first word
+std::vector<uint64_t> pack_kmc(const std::string &sequence) {
+    const size_t num_words = (sequence.size() + 31) / 32;
+    std::vector<uint64_t> words(num_words, 0);
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        size_t pos = sequence.size() - 1 - i;
+        uint64_t code = std::string("ACGT").find(sequence[i]);
+        words[num_words - 1 - pos / 32] |= code << (pos % 32 * 2);
+    }
+    return words;
+}
+
+TEST(BOSSConstruct, ConstructionFromPackedKmers) {
+    std::vector<std::string> input_data = {
+        "ACAGCTAGCTAGCTAGCTAGCTG",
+        "ATATTATAAAAAATTTTAAAAAA",
+        "ATATATTCTCTCTCTCTCATA",
+        "GTGTGTGTGGGGGGCCCTTTTTTCATAGTGTGTGTGGGGGGCCCTTTTTTCATA",
+    };
+    for (size_t k = 1; k < 30; ++k) {
+        for (bool both_strands : { false, true }) {
+            for (bool weighted : { false, true }) {
+                BOSSConstructor expected_constructor(k, both_strands, weighted ? 8 : 0);
+                std::vector<std::pair<std::string, uint64_t>> sequences;
+                for (const auto &sequence : input_data) {
+                    sequences.emplace_back(sequence, 3);
+                }
+                expected_constructor.add_sequences(std::move(sequences));
+                BOSS expected(&expected_constructor);
+
+                BOSSConstructor constructor(k, both_strands, weighted ? 8 : 0, "", 2);
+                for (const auto &sequence : input_data) {
+                    constructor.add_packed_kmers(sequence.size(), pack_kmc(sequence), { 3 });
+                }
+                BOSS constructed(&constructor);
+
+                EXPECT_EQ(expected, constructed);
+            }
+        }
+    }
+}
+#endif
+
 TEST(BOSSConstruct, ConstructionLong) {
     for (size_t k = 1; k < kMaxK; ++k) {
         BOSS appended(k);
@@ -1,6 +1,10 @@
 #include "graph/representation/succinct/dbg_succinct.hpp"
 
 #include "graph/representation/base/sequence_graph.hpp"
+#include "common/block_table.hpp"
+
+#include <filesystem>
+#include <fstream>
 
 #include <gtest/gtest.h>
 
@@ -10,6 +14,9 @@ namespace {
 using namespace mtg;
 using namespace mtg::graph;
 
+const std::string test_data_dir = TEST_DATA_DIR;
+const std::string test_dump_basename = test_data_dir + "/dump_test_graph";
+
 TEST(DBGSuccinct, get_degree_with_source_dummy) {
     for (size_t k = 2; k < 10; ++k) {
         auto graph = std::make_unique<DBGSuccinct>(k);
@@ -526,4 +533,72 @@ TEST(DBGSuccinct, CallNodesWithSuffixMultipleInOut) {
     EXPECT_EQ(ref_node_str, node_str) << *graph;
 }
 
+TEST(DBGSuccinct, LoadWithAndWithoutBlockTable) {
+    const std::vector<std::string> sequences {
+        "AAACACTAGCTAGCATCGAC", "CTAGCTTTTTGGGCA", "ACTAACGTACCCCCATATAGCGCAT"
+    };
+    for (auto state : { boss::BOSS::State::STAT, boss::BOSS::State::FAST,
+                        boss::BOSS::State::DYN, boss::BOSS::State::SMALL }) {
+        DBGSuccinct graph(5);
+        for (const auto &sequence : sequences) {
+            graph.add_sequence(sequence);
+        }
+        graph.switch_state(state);
+        graph.serialize(test_dump_basename);
+
+        std::vector<std::string> kmers;
+        graph.call_kmers([&](auto, const std::string &kmer) { kmers.push_back(kmer); });
+
+        // the W and last arrays are loaded from two streams
+        const std::string fname = test_dump_basename + graph.file_extension();
+        {
+            DBGSuccinct loaded(2);
+            ASSERT_TRUE(loaded.load(test_dump_basename));
+            EXPECT_EQ(state, loaded.get_state());
+            std::vector<std::string> loaded_kmers;
+            loaded.call_kmers([&](auto, const std::string &kmer) {
+                loaded_kmers.push_back(kmer);
+            });
+            EXPECT_EQ(kmers, loaded_kmers);
+        }
+
+        // drop the table of blocks to emulate the legacy format
+        common::BlockTable block_table;
+        ASSERT_TRUE(block_table.load(fname));
+        std::filesystem::resize_file(fname, block_table.data_size());
+        ASSERT_FALSE(block_table.load(fname));
+        {
+            DBGSuccinct loaded(2);
+            ASSERT_TRUE(loaded.load(test_dump_basename));
+            EXPECT_EQ(state, loaded.get_state());
+            std::vector<std::string> loaded_kmers;
+            loaded.call_kmers([&](auto, const std::string &kmer) {
+                loaded_kmers.push_back(kmer);
+            });
+            EXPECT_EQ(kmers, loaded_kmers);
+        }
+    }
+}
+
+TEST(DBGSuccinct, LoadWithCorruptedBlock) {
+    DBGSuccinct graph(5);
+    graph.add_sequence("AAACACTAGCTAGCATCGACCTAGCTTTTTGGGCA");
+    graph.serialize(test_dump_basename);
+    ASSERT_TRUE(DBGSuccinct(2).load(test_dump_basename));
+
+    const std::string fname = test_dump_basename + graph.file_extension();
+    common::BlockTable block_table;
+    ASSERT_TRUE(block_table.load(fname));
+
+    // flip a byte in the middle of the data, which the checksums must detect
+    {
+        std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(block_table.data_size() / 2);
+        char byte = file.get() ^ 1;
+        file.seekp(block_table.data_size() / 2);
+        file.put(byte);
+    }
+    EXPECT_FALSE(DBGSuccinct(2).load(test_dump_basename));
+}
+
 } // namespace
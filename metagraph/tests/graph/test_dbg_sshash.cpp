@@ -0,0 +1,90 @@
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "../test_helpers.hpp"
+#include "all/test_dbg_helpers.hpp"
+
+#include "graph/representation/hash/dbg_sshash.hpp"
+#include "graph/representation/succinct/dbg_succinct.hpp"
+
+
+namespace {
+
+#if ! _PROTEIN_GRAPH
+
+using namespace mtg;
+using namespace mtg::test;
+
+
+const std::vector<std::string> kSequences = {
+    "ACTAGCTAGCTAGCTAGCTAGC",
+    "ATCGATCGATCGATCGATCGATCGATCG",
+    "AATTTTTTTTTTTTCCCCCCCCCCCGGG",
+    "AATTTTTTTTTTTTCCCCCCCCCCCGGA",
+};
+
+std::set<std::string> get_kmers(const DeBruijnGraph &graph) {
+    std::set<std::string> kmers;
+    graph.call_kmers([&](auto, const std::string &kmer) { kmers.insert(kmer); });
+    return kmers;
+}
+
+
+TEST(DBGSSHash, ConstructFromMultipleSources) {
+    for (auto mode : { DeBruijnGraph::BASIC, DeBruijnGraph::CANONICAL }) {
+        auto reference = build_graph<DBGSSHash>(11, kSequences, mode);
+
+        // the input of SSHash must not have repeated k-mers
+        std::vector<std::string> contigs;
+        build_graph<DBGHashFast>(11, kSequences, mode)->call_sequences(
+            [&](const std::string &contig, const auto &) { contigs.push_back(contig); },
+            1, mode != DeBruijnGraph::BASIC
+        );
+
+        // stream the contigs, as if they came from multiple files
+        DBGSSHash graph([&](const DBGSSHash::CallSequence &callback) {
+            for (const auto &contig : contigs) {
+                callback(contig);
+            }
+        }, 11, mode);
+
+        EXPECT_EQ(reference->num_nodes(), graph.num_nodes());
+        EXPECT_EQ(get_kmers(*reference), get_kmers(graph));
+    }
+}
+
+TEST(DBGSSHash, ConstructFromEmptyInput) {
+    DBGSSHash graph([](const DBGSSHash::CallSequence &callback) { callback("ACG"); },
+                    11, DeBruijnGraph::BASIC);
+    EXPECT_EQ(0u, graph.num_nodes());
+}
+
+TEST(DBGSSHash, ConstructFromGraphAndMapNodes) {
+    for (auto mode : { DeBruijnGraph::BASIC, DeBruijnGraph::CANONICAL }) {
+        for (size_t num_threads : { 1, 4 }) {
+            auto source = build_graph_batch<DBGSuccinct>(11, kSequences, mode);
+
+            DBGSSHash graph(*source, num_threads);
+            EXPECT_EQ(source->num_nodes(), graph.num_nodes());
+            EXPECT_EQ(get_kmers(*source), get_kmers(graph));
+
+            auto mapping = graph.map_nodes_from(*source, num_threads);
+            ASSERT_EQ(source->max_index() + 1, mapping.size());
+
+            std::set<DeBruijnGraph::node_index> mapped;
+            source->call_nodes([&](auto node) {
+                ASSERT_NE(DeBruijnGraph::npos, mapping[node]);
+                EXPECT_EQ(source->get_node_sequence(node),
+                          graph.get_node_sequence(mapping[node]));
+                mapped.insert(mapping[node]);
+            });
+            // the mapping is a permutation
+            EXPECT_EQ(source->num_nodes(), mapped.size());
+        }
+    }
+}
+
+#endif // ! _PROTEIN_GRAPH
+
+} // namespace
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include <set>
+
+#include "../test_helpers.hpp"
+#include "all/test_dbg_helpers.hpp"
+
+#include "graph/representation/delta_dbg.hpp"
+
+
+namespace {
+
+using namespace mtg;
+using namespace mtg::test;
+
+std::set<std::string> get_kmers(const DeBruijnGraph &graph) {
+    std::set<std::string> kmers;
+    graph.call_kmers([&](auto, const std::string &kmer) { kmers.insert(kmer); });
+    return kmers;
+}
+
+
+TEST(DeltaDBG, AddSequenceKeepsBaseNodes) {
+    for (auto mode : { DeBruijnGraph::BASIC, DeBruijnGraph::CANONICAL }) {
+        const size_t k = 5;
+        const std::string base_seq = "AAACACTAGCTAGCATCGAC";
+        const std::string new_seq = "CTAGCTTTTTGGGCA";
+        auto base = build_graph_batch<DBGSuccinct>(k, { base_seq }, mode);
+        const auto base_nodes = map_to_nodes_sequentially(*base, base_seq);
+
+        DeltaDBG graph(base);
+        ASSERT_EQ(base->num_nodes(), graph.num_nodes());
+
+        size_t num_inserted = 0;
+        graph.add_sequence(new_seq, [&](auto node) {
+            EXPECT_LT(base->max_index(), node);
+            num_inserted++;
+        });
+        EXPECT_LT(0u, num_inserted);
+        EXPECT_EQ(graph.max_index(), base->max_index() + num_inserted);
+
+        // the nodes of the base graph are not affected
+        EXPECT_EQ(base_nodes, map_to_nodes_sequentially(graph, base_seq));
+
+        // adding the same sequence again inserts nothing
+        graph.add_sequence(new_seq, [&](auto) { ADD_FAILURE(); });
+        graph.add_sequence(base_seq, [&](auto) { ADD_FAILURE(); });
+
+        for (auto node : map_to_nodes_sequentially(graph, new_seq)) {
+            ASSERT_TRUE(graph.in_graph(node));
+        }
+
+        auto full = build_graph_batch<DBGSuccinct>(k, { base_seq, new_seq }, mode);
+        EXPECT_EQ(full->num_nodes(), graph.num_nodes());
+        EXPECT_EQ(get_kmers(*full), get_kmers(graph));
+    }
+}
+
+TEST(DeltaDBG, TraverseBetweenLayers) {
+    const size_t k = 5;
+    const std::string base_seq = "AAACACTAGCTAGCATCGAC";
+    const std::string new_seq = "CTAGCTTTTTGGGCA";
+    auto base = build_graph_batch<DBGSuccinct>(k, { base_seq });
+    auto full = build_graph_batch<DBGSuccinct>(k, { base_seq, new_seq });
+
+    DeltaDBG graph(base);
+    graph.add_sequence(new_seq);
+
+    full->call_kmers([&](auto full_node, const std::string &kmer) {
+        auto node = graph.kmer_to_node(kmer);
+        ASSERT_NE(DeBruijnGraph::npos, node);
+        EXPECT_EQ(kmer, graph.get_node_sequence(node));
+        EXPECT_EQ(full->outdegree(full_node), graph.outdegree(node)) << kmer;
+        EXPECT_EQ(full->indegree(full_node), graph.indegree(node)) << kmer;
+
+        for (char c : std::string("ACGT")) {
+            auto next = graph.traverse(node, c);
+            if (auto full_next = full->traverse(full_node, c)) {
+                ASSERT_NE(DeBruijnGraph::npos, next);
+                EXPECT_EQ(full->get_node_sequence(full_next), graph.get_node_sequence(next));
+            } else {
+                EXPECT_EQ(DeBruijnGraph::npos, next);
+            }
+
+            auto prev = graph.traverse_back(node, c);
+            if (auto full_prev = full->traverse_back(full_node, c)) {
+                ASSERT_NE(DeBruijnGraph::npos, prev);
+                EXPECT_EQ(full->get_node_sequence(full_prev), graph.get_node_sequence(prev));
+            } else {
+                EXPECT_EQ(DeBruijnGraph::npos, prev);
+            }
+        }
+    });
+}
+
+TEST(DeltaDBG, Compact) {
+    for (auto mode : { DeBruijnGraph::BASIC, DeBruijnGraph::CANONICAL }) {
+        for (size_t num_threads : { 1, 4 }) {
+            const size_t k = 7;
+            const std::vector<std::string> sequences {
+                "AGACACTGACGATCGATCGATGCTAGCTA",
+                "GACTACGTATTTTTTTGCGCGATCAGCTAC",
+                "ACTAACGTACCCCCATATAGCGCAT"
+            };
+            DeltaDBG graph(build_graph_batch<DBGSuccinct>(k, { sequences[0] }, mode));
+            graph.add_sequence(sequences[1]);
+            graph.add_sequence(sequences[2]);
+
+            auto compacted = graph.compact(num_threads);
+            auto full = build_graph_batch<DBGSuccinct>(k, sequences, mode);
+
+            EXPECT_EQ(full->num_nodes(), compacted->num_nodes());
+            EXPECT_EQ(get_kmers(*full), get_kmers(*compacted));
+        }
+    }
+}
+
+} // namespace
@@ -422,6 +422,32 @@ TEST(select_support_mcl, PredictedMemoryFootprint) {
     }
 }
 
+TEST(bit_vector_stat, ParallelSupport) {
+    DataGenerator gen;
+    gen.set_seed(42);
+
+    for (double density : { .01, .3, .9 }) {
+        sdsl::bit_vector bv = gen.generate_random_column(10'000'000, density);
+
+        set_num_threads(1);
+        bit_vector_stat expected(bv);
+        set_num_threads(4);
+        bit_vector_stat parallel(bv);
+        set_num_threads(1);
+
+        ASSERT_EQ(expected.num_set_bits(), parallel.num_set_bits());
+        for (uint64_t i = 0; i <= bv.size(); i += 9'973) {
+            ASSERT_EQ(expected.rank1(i), parallel.rank1(i));
+        }
+        for (uint64_t r = 1; r <= expected.num_set_bits(); r += 997) {
+            ASSERT_EQ(expected.select1(r), parallel.select1(r));
+        }
+        for (uint64_t r = 1; r <= bv.size() - expected.num_set_bits(); r += 99'991) {
+            ASSERT_EQ(expected.select0(r), parallel.select0(r));
+        }
+    }
+}
+
 TYPED_TEST(BitVectorTest, Serialization) {
     std::vector<std::initializer_list<bool>> init_lists = {
         { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include <set>
 #include <unordered_set>
 #include <string>
 
@@ -11,6 +12,8 @@ namespace {
 using namespace mtg;
 
 using mtg::seq_io::read_kmers;
+using mtg::seq_io::read_kmers_packed;
+using mtg::seq_io::read_kmer_counts;
 
 const std::string kTestDataDir = "../tests/data";
 // constructed with '-b' flag in KMC
@@ -345,4 +348,52 @@ TEST(kmc_parser, ReadKmersBothStrandsMaxCountThreshold) {
     }
 }
 
+TEST(kmc_parser, ReadKmersPacked) {
+    auto unpack = [](const uint64_t *words, size_t k) {
+        std::string kmer(k, '\0');
+        const size_t num_words = (k + 31) / 32;
+        for (size_t i = 0; i < k; ++i) {
+            size_t pos = k - 1 - i;
+            kmer[i] = "ACGT"[(words[num_words - 1 - pos / 32] >> (pos % 32 * 2)) & 3];
+        }
+        return kmer;
+    };
+
+    for (const auto &file : { kTestKMCDatabase, kTestKMCDatabaseCanonical }) {
+        for (bool call_both : { false, true }) {
+            std::multiset<std::pair<std::string, uint64_t>> expected;
+            read_kmers(file, [&](std::string_view string, uint64_t count) {
+                expected.emplace(string, count);
+            }, call_both, 2);
+
+            std::multiset<std::pair<std::string, uint64_t>> kmers;
+            read_kmers_packed(file, [&](size_t k, auto&& packed, auto&& counts) {
+                ASSERT_EQ(11u, k);
+                const size_t num_words = (k + 31) / 32;
+                ASSERT_EQ(packed.size(), counts.size() * num_words);
+                ASSERT_GE(1000u, counts.size());
+                for (size_t i = 0; i < counts.size(); ++i) {
+                    kmers.emplace(unpack(&packed[i * num_words], k), counts[i]);
+                }
+            }, call_both, 2, -1, 1000);
+
+            EXPECT_EQ(expected, kmers);
+        }
+    }
+}
+
+TEST(kmc_parser, ReadKmerCounts) {
+    for (const auto &file : { kTestKMCDatabase, kTestKMCDatabaseCanonical }) {
+        std::multiset<uint64_t> expected;
+        read_kmers(file, [&](std::string_view, uint64_t count) {
+            expected.insert(count);
+        }, false);
+
+        std::multiset<uint64_t> counts;
+        read_kmer_counts(file, [&](uint64_t count) { counts.insert(count); });
+
+        EXPECT_EQ(expected, counts);
+    }
+}
+
 } // namespace
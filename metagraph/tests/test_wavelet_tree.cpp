@@ -458,6 +458,31 @@ TYPED_TEST(WaveletTreeTest, initialize_large) {
     EXPECT_EQ(initial_content.size(), vector.size());
 }
 
+TYPED_TEST(WaveletTreeTest, initialize_parallel) {
+    std::vector<uint64_t> numbers(1'000'000);
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        // skip some characters to leave some of the bitmaps empty
+        numbers[i] = (i * 87'178'291'199) % 7 * 2;
+    }
+
+    set_num_threads(1);
+    TypeParam expected(4, numbers);
+    set_num_threads(4);
+    TypeParam parallel(4, numbers);
+    set_num_threads(1);
+
+    ASSERT_EQ(numbers, to_std_vector(parallel.to_vector()));
+    for (uint64_t c = 0; c < 16; ++c) {
+        ASSERT_EQ(expected.count(c), parallel.count(c));
+        for (uint64_t i = 0; i < numbers.size(); i += 9'973) {
+            ASSERT_EQ(expected.rank(c, i), parallel.rank(c, i));
+        }
+        for (uint64_t r = 1; r <= expected.count(c); r += 997) {
+            ASSERT_EQ(expected.select(c, r), parallel.select(c, r));
+        }
+    }
+}
+
 TYPED_TEST(WaveletTreeTest, operator_eq) {
     for (uint64_t size : { 0, 10, 64, 120, 128, 1000, 10000, 10000 }) {
         for (int value : { 0, 1, 2, 5 }) {